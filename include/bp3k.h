@@ -1,9 +1,27 @@
 #ifndef _BITPACKER3000_H_
 #define _BITPACKER3000_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
+
+namespace bp3k {
+
+/// @brief Storage policy: signed values are packed as W-bit two's complement
+struct twos_complement final {};
+
+/// @brief Storage policy: signed values are packed as zigzag codes
+///
+/// Maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... so small magnitudes get small
+/// unsigned codes and reads decode with a shift and XOR (no sign extension).
+struct zigzag final {};
+
+template <typename T, std::size_t W, typename E = twos_complement>
+class item_proxy;
+
+}  // namespace bp3k
 
 /// @internal
 /// @brief Implementation details
@@ -140,12 +158,54 @@ struct impl_type_map<T, true> final {
 template <typename T>
 using impl_type = typename impl_type_map<T, std::is_enum<T>::value>::type;
 
-/// @brief Dispatches bit-packing operations based on type configuration
+/// @brief Hints that the cache line holding `address` is needed soon
+/// @tparam ForWrite `true` if the line will be written
+/// @param address Any address within the line
+template <bool ForWrite = false>
+inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, ForWrite ? 1 : 0);
+#else
+  (void)address;
+#endif
+}
+
+/// @brief Decoded values of every byte for widths that divide 8
+/// @tparam T I/O value type
+/// @tparam W Bit width of packed values (1, 2 or 4)
+/// @tparam Lane Lane dispatcher that decodes one value
+template <typename T, std::size_t W, typename Lane>
+struct byte_table final {
+  static_assert(W == 1 || W == 2 || W == 4, "W must divide 8");
+
+  /// @brief Number of values per byte
+  static constexpr std::size_t per_byte = 8 / W;
+
+  /// @brief `values[b][i]` is the i-th (most significant first) value of `b`
+  T values[256][per_byte];
+
+  /// @brief Generates the table
+  inline constexpr byte_table() noexcept : values{} {
+    for (std::size_t b = 0; b < 256; ++b) {
+      std::uintmax_t word = b;
+
+      for (std::size_t i = 0; i < per_byte; ++i)
+        this->values[b][i] =
+            static_cast<T>(Lane::extract_value(&word, 8 - W * (i + 1)));
+    }
+  }
+};
+
+/// @brief Shared instance of `byte_table<T, W, Lane>`
+template <typename T, std::size_t W, typename Lane>
+inline constexpr byte_table<T, W, Lane> byte_table_v{};
+
+/// @brief Dispatches N-independent lane operations based on type configuration
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
-/// @tparam N Packed-value capacity
-template <typename T, std::size_t W, std::size_t N>
-class type_dispatcher final {
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <typename T, std::size_t W, typename E = twos_complement>
+class lane_dispatcher {
   static constexpr bool t_is_enum = std::is_enum<T>::value;
   static constexpr std::size_t t_width = sizeof(T) << 3;
   using integral_type = impl_type<T>;
@@ -163,26 +223,26 @@ class type_dispatcher final {
   static constexpr std::size_t word_width_log2 = msb_log2<word_width>();
   static constexpr std::size_t per_word = word_width / W;
   static constexpr std::size_t per_word_log2 = word_width_log2 - w_log2;
-  static constexpr std::size_t extra_items = N % per_word;
-  static constexpr std::size_t last_word_items =
-      extra_items > 0 ? extra_items : per_word;
-  static constexpr std::size_t word_count =
-      (N / per_word) + (std::size_t)(per_word != last_word_items);
-  static constexpr std::size_t max_size = word_count * per_word;
-  static constexpr unsigned_type value_mask = (unsigned_type)((1 << W) - 1);
+  static constexpr unsigned_type value_mask =
+      (unsigned_type)(~(std::uintmax_t)0 >> (word_width - W));
   static constexpr unsigned_type sign_extend_bits = (unsigned_type)~value_mask;
-  static constexpr unsigned_type sign_bit_mask = (unsigned_type)(1 << (W - 1));
+  static constexpr unsigned_type sign_bit_mask =
+      (unsigned_type)((std::uintmax_t)1 << (W - 1));
   static constexpr bool w_is_power_of_2 = is_power_of_2<W>;
   static constexpr std::size_t front_offset = word_width - W;
-  static constexpr std::size_t back_offset =
-      word_width - (W * (last_word_items));
+  static constexpr bool is_zigzag = std::is_same<E, zigzag>::value;
+
+  static_assert(std::is_same<E, twos_complement>::value || is_zigzag,
+                "E must be bp3k::twos_complement or bp3k::zigzag");
+  static_assert(!is_zigzag || t_is_signed,
+                "zigzag storage requires a signed T");
 
   /// @brief Computes minimum value for width W
   /// @return Result of computation
   static inline constexpr T value_min() noexcept {
     if constexpr (!t_is_signed) return (T)0;
 
-    return (T)(-(integral_type)sign_bit_mask);
+    return (T)(integral_type)(unsigned_type)(sign_extend_bits | sign_bit_mask);
   }
 
   /// @brief Computes maximum value for width W
@@ -193,6 +253,14 @@ class type_dispatcher final {
     return (T)(value_mask >> 1);
   }
 
+  /// @brief Computes number of words needed to hold `item_count` items
+  /// @param item_count Number of packed items
+  /// @return Word count
+  static inline constexpr std::size_t words_for(
+      std::size_t item_count) noexcept {
+    return (item_count + per_word - 1) / per_word;
+  }
+
   /// @brief Computes word index
   /// @param item_pos Index of item in the bitpacker
   /// @return Index of word
@@ -235,6 +303,26 @@ class type_dispatcher final {
     return w_bits | mask;
   }
 
+  /// @brief Maps a value to the bits stored for it
+  /// @param value Value (T converted to its unsigned counterpart)
+  /// @return Stored bits (before masking to W)
+  static inline constexpr unsigned_type encode_value(
+      unsigned_type value) noexcept {
+    if constexpr (!is_zigzag) return value;
+
+    auto sign = (unsigned_type)(0 - (unsigned_type)(value >> (t_width - 1)));
+    return (unsigned_type)((unsigned_type)(value << 1) ^ sign);
+  }
+
+  /// @brief Maps zigzag-coded bits back to a value
+  /// @param w_bits Raw packed bits
+  /// @return Decoded value (T converted to its unsigned counterpart)
+  static inline constexpr unsigned_type decode_zigzag(
+      unsigned_type w_bits) noexcept {
+    auto sign = (unsigned_type)(0 - (unsigned_type)(w_bits & 1));
+    return (unsigned_type)((w_bits >> 1) ^ sign);
+  }
+
   /// @brief Packs a value into a word
   /// @param word_ptr Pointer to word
   /// @param offset Item offset within word
@@ -243,7 +331,7 @@ class type_dispatcher final {
                                            std::size_t offset,
                                            unsigned_type value) noexcept {
     auto clear_mask = ~((std::uintmax_t)value_mask << offset);
-    auto w_bits = (std::uintmax_t)(value & value_mask);
+    auto w_bits = (std::uintmax_t)(encode_value(value) & value_mask);
 
     *word_ptr &= clear_mask;
     *word_ptr |= w_bits << offset;
@@ -257,11 +345,209 @@ class type_dispatcher final {
       const std::uintmax_t* word_ptr, std::size_t offset) noexcept {
     auto w_bits = static_cast<unsigned_type>(*word_ptr >> offset) & value_mask;
 
+    if constexpr (is_zigzag) return decode_zigzag(w_bits);
+
     if constexpr (!t_is_signed) return w_bits;
 
     return extend_sign(w_bits);
   }
 
+  /// @brief Decodes every lane of a word
+  /// @param word Word
+  /// @param out Output with `per_word` values (lane 0 first)
+  static inline constexpr void decode_word(std::uintmax_t word,
+                                           T* out) noexcept {
+    decode_word(word, out, std::make_index_sequence<per_word>{});
+  }
+
+  /// @brief Encodes `per_word` values into one word
+  /// @param values Input with `per_word` values (lane 0 first)
+  /// @return Word
+  static inline constexpr std::uintmax_t encode_word(const T* values) noexcept {
+    return encode_word(values, std::make_index_sequence<per_word>{});
+  }
+
+  template <std::size_t... Is>
+  static inline constexpr void decode_word(
+      std::uintmax_t word, T* out, std::index_sequence<Is...>) noexcept {
+    ((out[Is] = static_cast<T>(extract_value(&word, front_offset - Is * W))),
+     ...);
+  }
+
+  template <std::size_t... Is>
+  static inline constexpr std::uintmax_t encode_word(
+      const T* values, std::index_sequence<Is...>) noexcept {
+    return ((static_cast<std::uintmax_t>(
+                 encode_value((unsigned_type)values[Is]) & value_mask)
+             << (front_offset - Is * W)) |
+            ...);
+  }
+
+  /// @brief Whether whole words decode through a `byte_table`
+  static constexpr bool use_byte_table = W == 1 || W == 2 || W == 4;
+
+  /// @brief Visits consecutive items in order
+  /// @tparam F Callable as `f(T)`
+  /// @param words Pointer to first word
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param f Visitor
+  template <typename F>
+  static inline constexpr void for_each(const std::uintmax_t* words,
+                                        std::size_t pos, std::size_t count,
+                                        F&& f) {
+    auto end = pos + count;
+
+    // Head: items up to the next word boundary
+    for (; pos < end && item_offset(pos) != front_offset; ++pos)
+      f(static_cast<T>(
+          extract_value(&words[word_index(pos)], item_offset(pos))));
+
+    for (; end - pos >= per_word; pos += per_word) {
+      auto word = words[word_index(pos)];
+
+      if constexpr (use_byte_table) {
+        constexpr auto& table =
+            byte_table_v<T, W, lane_dispatcher<T, W, E>>.values;
+
+        for (auto shift = word_width; shift != 0;) {
+          shift -= 8;
+
+          for (auto x : table[(word >> shift) & 0xff]) f(x);
+        }
+      } else {
+        auto offset = front_offset;
+
+        for (std::size_t i = 0; i < per_word; ++i, offset -= W)
+          f(static_cast<T>(extract_value(&word, offset)));
+      }
+    }
+
+    for (; pos < end; ++pos)
+      f(static_cast<T>(
+          extract_value(&words[word_index(pos)], item_offset(pos))));
+  }
+
+  /// @brief Decodes consecutive items
+  /// @param words Pointer to first word
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  static inline constexpr void unpack(const std::uintmax_t* words,
+                                      std::size_t pos, std::size_t count,
+                                      T* out) noexcept {
+    for_each(words, pos, count, [&out](T x) { *out++ = x; });
+  }
+
+  /// @brief Number of lookups planned (and prefetched) ahead by `gather()`
+  /// and `scatter()`
+  static constexpr std::size_t batch_size = 16;
+
+  /// @brief Computes word indices and offsets for a batch and prefetches
+  /// @tparam ForWrite `true` if the words will be written
+  /// @param words Pointer to first word
+  /// @param indices Item indices
+  /// @param count Number of indices (at most `batch_size`)
+  /// @param word_indices Output word indices
+  /// @param offsets Output item offsets
+  template <bool ForWrite>
+  static inline void plan_batch(const std::uintmax_t* words,
+                                const std::size_t* indices, std::size_t count,
+                                std::size_t* word_indices,
+                                std::size_t* offsets) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      word_indices[i] = word_index(indices[i]);
+      offsets[i] = item_offset(indices[i]);
+      prefetch<ForWrite>(&words[word_indices[i]]);
+    }
+  }
+
+  /// @brief Reads items at arbitrary indices
+  /// @param words Pointer to first word
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param out Output values (`out[i]` is item `indices[i]`)
+  static inline void gather(const std::uintmax_t* words,
+                            const std::size_t* indices, std::size_t count,
+                            T* out) noexcept {
+    std::size_t word_indices[2][batch_size];
+    std::size_t offsets[2][batch_size];
+    std::size_t cached = ~(std::size_t)0;
+    std::uintmax_t word{};
+
+    // While one batch decodes, the loads of the next one are in flight
+    plan_batch<false>(words, indices, count < batch_size ? count : batch_size,
+                      word_indices[0], offsets[0]);
+
+    for (std::size_t base = 0, b = 0; base < count; base += batch_size) {
+      auto n = count - base < batch_size ? count - base : batch_size;
+      auto next = base + batch_size;
+
+      if (next < count) {
+        auto next_n = count - next < batch_size ? count - next : batch_size;
+        plan_batch<false>(words, &indices[next], next_n, word_indices[b ^ 1],
+                          offsets[b ^ 1]);
+      }
+
+      for (std::size_t i = 0; i < n; ++i) {
+        // Runs of indices within one word share a single load
+        if (word_indices[b][i] != cached) {
+          cached = word_indices[b][i];
+          word = words[cached];
+        }
+
+        out[base + i] = static_cast<T>(extract_value(&word, offsets[b][i]));
+      }
+
+      b ^= 1;
+    }
+  }
+
+  /// @brief Writes items at arbitrary indices (later duplicates win)
+  /// @param words Pointer to first word
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param values Input values (`values[i]` goes to item `indices[i]`)
+  static inline void scatter(std::uintmax_t* words,
+                             const std::size_t* indices, std::size_t count,
+                             const T* values) noexcept {
+    std::size_t word_indices[2][batch_size];
+    std::size_t offsets[2][batch_size];
+    std::size_t cached = ~(std::size_t)0;
+    std::uintmax_t word{};
+
+    plan_batch<true>(words, indices, count < batch_size ? count : batch_size,
+                     word_indices[0], offsets[0]);
+
+    for (std::size_t base = 0, b = 0; base < count; base += batch_size) {
+      auto n = count - base < batch_size ? count - base : batch_size;
+      auto next = base + batch_size;
+
+      if (next < count) {
+        auto next_n = count - next < batch_size ? count - next : batch_size;
+        plan_batch<true>(words, &indices[next], next_n, word_indices[b ^ 1],
+                         offsets[b ^ 1]);
+      }
+
+      for (std::size_t i = 0; i < n; ++i) {
+        // Runs of indices within one word share a single load and store
+        if (word_indices[b][i] != cached) {
+          if (cached != ~(std::size_t)0) words[cached] = word;
+
+          cached = word_indices[b][i];
+          word = words[cached];
+        }
+
+        embed_value(&word, offsets[b][i],
+                    static_cast<unsigned_type>(values[base + i]));
+      }
+
+      b ^= 1;
+    }
+
+    if (cached != ~(std::size_t)0) words[cached] = word;
+  }
+
   /// @brief Fills a word with a repeated packed value
   /// @tparam PackCount Number of values to embed
   /// @param mask0 Left-most value mask
@@ -279,19 +565,105 @@ class type_dispatcher final {
     return word;
   }
 
+  /// @brief Fills words with a repeated packed value
+  /// @param word_ptr Pointer to first word
+  /// @param word_count Number of words (non-zero)
+  /// @param last_items Number of items in the last word
+  /// @param value Fill value
+  static inline constexpr void fill_words(std::uintmax_t* word_ptr,
+                                          std::size_t word_count,
+                                          std::size_t last_items,
+                                          unsigned_type value) noexcept {
+    auto mask0 = static_cast<std::uintmax_t>(encode_value(value) & value_mask)
+                 << front_offset;
+    auto full = fill_word<per_word>(mask0);
+    auto last = last_items == per_word
+                    ? full
+                    : full & ~(~(std::uintmax_t)0 >> (last_items * W));
+
+    for (std::size_t i = 0; i + 1 < word_count; ++i) word_ptr[i] = full;
+
+    word_ptr[word_count - 1] = last;
+  }
+};
+
+/// @brief Compares word arrays lexicographically
+/// @param lhs Pointer to first word of left operand
+/// @param rhs Pointer to first word of right operand
+/// @param word_count Number of words
+/// @return Negative, zero or positive as `lhs` is below, equal or above `rhs`
+inline constexpr int compare_words(const std::uintmax_t* lhs,
+                                   const std::uintmax_t* rhs,
+                                   std::size_t word_count) noexcept {
+  for (std::size_t i = 0; i < word_count; ++i) {
+    if (lhs[i] != rhs[i]) return lhs[i] < rhs[i] ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/// @brief Exchanges the contents of two word arrays
+/// @param lhs Pointer to first word of one array
+/// @param rhs Pointer to first word of the other array
+/// @param word_count Number of words
+inline constexpr void swap_words(std::uintmax_t* lhs, std::uintmax_t* rhs,
+                                 std::size_t word_count) noexcept {
+  for (std::size_t i = 0; i < word_count; ++i) {
+    std::uintmax_t tmp = lhs[i];
+    lhs[i] = rhs[i];
+    rhs[i] = tmp;
+  }
+}
+
+/// @brief Dispatches bit-packing operations based on type configuration
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam N Packed-value capacity
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <typename T, std::size_t W, std::size_t N,
+          typename E = twos_complement>
+class type_dispatcher final : public lane_dispatcher<T, W, E> {
+  using lane = lane_dispatcher<T, W, E>;
+
+ public:
+  using typename lane::unsigned_type;
+
+  using lane::front_offset;
+  using lane::per_word;
+  using lane::value_mask;
+  using lane::word_width;
+
+  static constexpr std::size_t extra_items = N % per_word;
+  static constexpr std::size_t last_word_items =
+      extra_items > 0 ? extra_items : per_word;
+  static constexpr std::size_t word_count =
+      (N / per_word) + (std::size_t)(per_word != last_word_items);
+  static constexpr std::size_t max_size = word_count * per_word;
+  static constexpr std::size_t back_offset =
+      word_width - (W * (last_word_items));
+
   /// @brief Fills word buffer with a repeated packed value
   /// @param word_ptr Pointer to first word
   /// @param value Fill value
   static inline constexpr void fill_buffer(std::uintmax_t* word_ptr,
                                            unsigned_type value) noexcept {
-    std::uintmax_t mask0 = static_cast<std::uintmax_t>(value & value_mask)
-                           << front_offset;
-    std::size_t i{};
-
-    for (i = 0; i < word_count - 1; ++i)
-      word_ptr[i] = fill_word<per_word>(mask0);
+    lane::fill_words(word_ptr, word_count, last_word_items, value);
+  }
+};
 
-    word_ptr[i] = fill_word<last_word_items>(mask0);
+/// @brief Grants BP3K containers access to `item_proxy` construction
+struct proxy_access final {
+  /// @brief Constructs a proxy referencing a packed item
+  /// @tparam T I/O value type
+  /// @tparam W Bit width of packed values
+  /// @tparam E Storage policy
+  /// @param word_ptr Pointer to word
+  /// @param offset Offset within word
+  /// @return Reference to packed item
+  template <typename T, std::size_t W, typename E = twos_complement>
+  static inline constexpr item_proxy<T, W, E> make(
+      std::uintmax_t* word_ptr, std::size_t offset) noexcept {
+    return item_proxy<T, W, E>(word_ptr, offset);
   }
 };
 
@@ -301,70 +673,147 @@ class type_dispatcher final {
 /// @brief Root namespace for the BP3K library
 namespace bp3k {
 
+/// @brief Proxy object that provides reference to packed item
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <typename T, std::size_t W, typename E>
+class item_proxy final {
+  using lane_dispatcher = impl::lane_dispatcher<T, W, E>;
+
+  /// @brief Pointer to word that holds the packed item
+  std::uintmax_t* const word_ptr_;
+  /// @brief Offset of packed item within word
+  const std::size_t offset_;
+
+  /// @brief Constructor for item referencing
+  /// @param word_ptr Pointer to word
+  /// @param offset Offset within word
+  inline constexpr item_proxy(std::uintmax_t* word_ptr,
+                              std::size_t offset) noexcept
+      : word_ptr_(word_ptr), offset_(offset) {}
+
+  /// @brief
+  friend struct impl::proxy_access;
+
+ public:
+  /// @brief Copy constructor (default)
+  /// @param
+  item_proxy(const item_proxy&) = default;
+
+  /// @brief Destructor (default)
+  ~item_proxy() = default;
+
+  /// @brief Assigns value to referenced item
+  /// @param x Value
+  /// @return Self reference
+  inline constexpr item_proxy& operator=(T x) noexcept {
+    using unsigned_type = typename lane_dispatcher::unsigned_type;
+
+    lane_dispatcher::embed_value(this->word_ptr_, this->offset_,
+                                 static_cast<unsigned_type>(x));
+    return *this;
+  }
+
+  /// @brief Assigns value to referenced item from another referenced item
+  /// @param rhs Reference to other item
+  /// @return Self reference
+  inline constexpr item_proxy& operator=(const item_proxy& rhs) noexcept {
+    auto value = lane_dispatcher::extract_value(rhs.word_ptr_, rhs.offset_);
+    lane_dispatcher::embed_value(this->word_ptr_, this->offset_, value);
+    return *this;
+  }
+
+  /// @brief Extracts value from referenced item
+  inline constexpr operator T() const noexcept {
+    return (T)lane_dispatcher::extract_value(this->word_ptr_, this->offset_);
+  }
+};
+
+/// @brief Cache line size assumed by alignment options
+constexpr std::size_t cache_line_size = 64;
+
+/// @brief Storage layout figures of a packed container
+struct layout_info final {
+  /// @brief Number of items
+  std::size_t item_count;
+  /// @brief Bits per item
+  std::size_t width;
+  /// @brief Items per word
+  std::size_t per_word;
+  /// @brief Number of storage words
+  std::size_t word_count;
+  /// @brief Alignment of the storage in bytes
+  std::size_t alignment;
+  /// @brief Object size in bytes (including alignment padding)
+  std::size_t bytes_used;
+  /// @brief Smallest byte count able to hold `item_count * width` bits
+  std::size_t min_bytes;
+  /// @brief Bits of `bytes_used` that hold no item
+  std::size_t wasted_bits;
+  /// @brief Cache lines spanned when the object starts on a line boundary
+  std::size_t cache_lines;
+
+  /// @brief Fraction of the object's bits holding items
+  /// @return Density in `[0, 1]` (1 for an empty layout)
+  inline constexpr double density() const noexcept {
+    return this->bytes_used != 0
+               ? (double)(this->item_count * this->width) /
+                     (double)(this->bytes_used * 8)
+               : 1.0;
+  }
+};
+
 /// @brief Bit-packing array template
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
-template <typename T, std::size_t W, std::size_t N>
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+/// @tparam A Storage alignment in bytes (e.g. `cache_line_size`)
+///
+/// Items never straddle words, so one access touches one word (and thus one
+/// cache line). Raising `A` to `cache_line_size` additionally starts every
+/// packer on a line boundary and pads its size to whole lines, so packers
+/// placed in arrays never share a line and full scans touch the minimum
+/// number of lines.
+template <typename T, std::size_t W, std::size_t N,
+          typename E = twos_complement,
+          std::size_t A = alignof(std::uintmax_t)>
 class bitpacker final {
-  using type_dispatcher = impl::type_dispatcher<T, W, N>;
+  using type_dispatcher = impl::type_dispatcher<T, W, N, E>;
 
-  std::uintmax_t data_[type_dispatcher::word_count]{};
+  static_assert(impl::is_power_of_2<A> && A >= alignof(std::uintmax_t),
+                "A must be a power of 2 no smaller than a word's alignment");
 
- public:
-  /// @brief
-  friend class item_proxy;
+  alignas(A) std::uintmax_t data_[type_dispatcher::word_count]{};
 
-  /// @brief Proxy object that provides reference to packed item
-  class item_proxy final {
-    /// @brief Pointer to word that holds the packed item
-    std::uintmax_t* const word_ptr_;
-    /// @brief Offset of packed item within word
-    const std::size_t offset_;
-
-    /// @brief Constructor for item referencing
-    /// @param word_ptr Pointer to word
-    /// @param offset Offset within word
-    inline constexpr item_proxy(std::uintmax_t* word_ptr,
-                                std::size_t offset) noexcept
-        : word_ptr_(word_ptr), offset_(offset) {}
-
-    /// @brief
-    friend class bitpacker;
-
-   public:
-    /// @brief Copy constructor (default)
-    /// @param
-    item_proxy(const item_proxy&) = default;
-
-    /// @brief Destructor (default)
-    ~item_proxy() = default;
-
-    /// @brief Assigns value to referenced item
-    /// @param x Value
-    /// @return Self reference
-    inline constexpr item_proxy& operator=(T x) noexcept {
-      using unsigned_type = typename type_dispatcher::unsigned_type;
-
-      type_dispatcher::embed_value(this->word_ptr_, this->offset_,
-                                   static_cast<unsigned_type>(x));
-      return *this;
-    }
+  static constexpr std::size_t word_bytes =
+      type_dispatcher::word_count * sizeof(std::uintmax_t);
 
-    /// @brief Assigns value to referenced item from another referenced item
-    /// @param rhs Reference to other item
-    /// @return Self reference
-    inline constexpr item_proxy& operator=(const item_proxy& rhs) noexcept {
-      auto value = type_dispatcher::extract_value(rhs.word_ptr_, rhs.offset_);
-      type_dispatcher::embed_value(this->word_ptr_, this->offset_, value);
-      return *this;
-    }
+ public:
+  /// @brief Number of items per storage word
+  static constexpr std::size_t per_word = type_dispatcher::per_word;
+
+  /// @brief Number of storage words
+  static constexpr std::size_t word_count = type_dispatcher::word_count;
+
+  /// @brief Decoded items of one storage word (lane 0 first)
+  using word_items = std::array<T, per_word>;
+
+  /// @brief Storage layout figures, usable in `static_assert`
+  static constexpr layout_info layout = {
+      N,
+      W,
+      type_dispatcher::per_word,
+      type_dispatcher::word_count,
+      A,
+      (word_bytes + A - 1) / A * A,
+      (N * W + 7) / 8,
+      (word_bytes + A - 1) / A * A * 8 - N * W,
+      ((word_bytes + A - 1) / A * A + cache_line_size - 1) / cache_line_size};
 
-    /// @brief Extracts value from referenced item
-    inline constexpr operator T() const noexcept {
-      return (T)type_dispatcher::extract_value(this->word_ptr_, this->offset_);
-    }
-  };
+  /// @brief Proxy object that provides reference to packed item
+  using item_proxy = bp3k::item_proxy<T, W, E>;
 
   /// @brief T
   using value_type = T;
@@ -372,6 +821,9 @@ class bitpacker final {
   /// @brief Storage type
   using word_type = std::uintmax_t;
 
+  /// @brief Storage policy
+  using encoding_type = E;
+
   /// @brief bitpacker<T, W, N>::item_proxy
   using reference = item_proxy;
 
@@ -401,7 +853,7 @@ class bitpacker final {
   inline constexpr reference at(std::size_t pos) noexcept {
     auto word_index = type_dispatcher::word_index(pos);
     auto offset = type_dispatcher::item_offset(pos);
-    return reference(&this->data_[word_index], offset);
+    return impl::proxy_access::make<T, W, E>(&this->data_[word_index], offset);
   }
 
   /// @brief Fetches value of packed item
@@ -421,7 +873,7 @@ class bitpacker final {
   inline constexpr reference operator[](std::size_t pos) noexcept {
     auto word_index = type_dispatcher::word_index(pos);
     auto offset = type_dispatcher::item_offset(pos);
-    return reference(&this->data_[word_index], offset);
+    return impl::proxy_access::make<T, W, E>(&this->data_[word_index], offset);
   }
 
   /// @brief Fetches value of packed item
@@ -435,10 +887,102 @@ class bitpacker final {
     return static_cast<T>(w_bits);
   }
 
+  /// @brief Decodes consecutive items
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  inline constexpr void unpack(std::size_t pos, std::size_t count,
+                               T* out) const noexcept {
+    type_dispatcher::unpack(this->data_, pos, count, out);
+  }
+
+  /// @brief Visits all items in order
+  /// @tparam F Callable as `f(T)`
+  /// @param f Visitor
+  template <typename F>
+  inline constexpr void for_each(F&& f) const {
+    type_dispatcher::for_each(this->data_, 0, N, f);
+  }
+
+  /// @brief Counts occurrences of every representable value
+  /// @param counts Output with `2^W` entries; `counts[k]` is incremented for
+  /// each item equal to `value_min + k`
+  inline constexpr void histogram(std::size_t* counts) const noexcept {
+    using unsigned_type = typename type_dispatcher::unsigned_type;
+
+    static_assert(W <= 16, "histogram() needs W <= 16");
+
+    type_dispatcher::for_each(this->data_, 0, N, [counts](T x) {
+      auto k = (unsigned_type)((unsigned_type)x - (unsigned_type)value_min);
+      ++counts[k & type_dispatcher::value_mask];
+    });
+  }
+
+  /// @brief Reads a batch of items at arbitrary indices
+  ///
+  /// Word loads are planned and prefetched one batch ahead, so independent
+  /// cache misses overlap; sorting `indices` lets neighbours share loads.
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param out Output values (`out[i]` is item `indices[i]`)
+  inline void gather(const std::size_t* indices, std::size_t count,
+                     T* out) const noexcept {
+    type_dispatcher::gather(this->data_, indices, count, out);
+  }
+
+  /// @brief Writes a batch of items at arbitrary indices
+  ///
+  /// Same pipelining as `gather()`; repeated indices keep the last value.
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param values Input values (`values[i]` goes to item `indices[i]`)
+  inline void scatter(const std::size_t* indices, std::size_t count,
+                      const T* values) noexcept {
+    type_dispatcher::scatter(this->data_, indices, count, values);
+  }
+
+  /// @brief Decodes all items of one storage word
+  /// @param word_idx Index of word
+  /// @param items Output; lanes past item `N - 1` decode as zero bits
+  inline constexpr void load_word_items(std::size_t word_idx,
+                                        word_items& items) const noexcept {
+    type_dispatcher::decode_word(this->data_[word_idx], items.data());
+  }
+
+  /// @brief Encodes all items of one storage word
+  /// @param word_idx Index of word
+  /// @param items Input; lanes past item `N - 1` are ignored
+  inline constexpr void store_word_items(std::size_t word_idx,
+                                         const word_items& items) noexcept {
+    auto word = type_dispatcher::encode_word(items.data());
+
+    if (word_idx == word_count - 1)
+      word &= ~(std::uintmax_t)0 << type_dispatcher::back_offset;
+
+    this->data_[word_idx] = word;
+  }
+
+  /// @brief Visits the decoded items of every storage word in order
+  /// @tparam F Callable as `f(std::size_t first, const word_items& items,
+  /// std::size_t count)`, where `first` is the index of `items[0]` and only
+  /// the first `count` items are part of the packer
+  /// @param f Visitor
+  template <typename F>
+  inline constexpr void for_each_word(F&& f) const {
+    word_items items{};
+
+    for (std::size_t w = 0; w < word_count; ++w) {
+      type_dispatcher::decode_word(this->data_[w], items.data());
+      f(w * per_word, static_cast<const word_items&>(items),
+        w + 1 < word_count ? per_word : type_dispatcher::last_word_items);
+    }
+  }
+
   /// @brief Fetches reference to first item
   /// @return Reference to first item
   inline constexpr reference front() noexcept {
-    return reference(&this->data_[0], type_dispatcher::front_offset);
+    return impl::proxy_access::make<T, W, E>(&this->data_[0],
+                                          type_dispatcher::front_offset);
   }
 
   /// @brief Fetches value of first item
@@ -452,8 +996,9 @@ class bitpacker final {
   /// @brief Fetches reference to last item
   /// @return Reference to last item
   inline constexpr reference back() noexcept {
-    return reference(&this->data_[type_dispatcher::word_count - 1],
-                     type_dispatcher::back_offset);
+    return impl::proxy_access::make<T, W, E>(
+        &this->data_[type_dispatcher::word_count - 1],
+        type_dispatcher::back_offset);
   }
 
   /// @brief Fetches value of last item
@@ -500,159 +1045,166 @@ class bitpacker final {
   /// @brief Exchanges the contents of the container with those of `other`
   /// @param rhs
   inline constexpr void swap(bitpacker& other) noexcept {
-    std::uintmax_t tmp{};
-
-    for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-      tmp = this->data_[i];
-      this->data_[i] = other.data_[i];
-      other.data_[i] = tmp;
-    }
+    impl::swap_words(this->data_, other.data_, type_dispatcher::word_count);
   }
 
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator==(const bitpacker<T_, W_, N_>& lhs,
-                                   const bitpacker<T_, W_, N_>& rhs) noexcept;
-
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator!=(const bitpacker<T_, W_, N_>& lhs,
-                                   const bitpacker<T_, W_, N_>& rhs) noexcept;
-
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator<(const bitpacker<T_, W_, N_>& lhs,
-                                  const bitpacker<T_, W_, N_>& rhs) noexcept;
-
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator<=(const bitpacker<T_, W_, N_>& lhs,
-                                   const bitpacker<T_, W_, N_>& rhs) noexcept;
-
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator>(const bitpacker<T_, W_, N_>& lhs,
-                                  const bitpacker<T_, W_, N_>& rhs) noexcept;
-
-  template <typename T_, std::size_t W_, std::size_t N_>
-  friend constexpr bool operator>=(const bitpacker<T_, W_, N_>& lhs,
-                                   const bitpacker<T_, W_, N_>& rhs) noexcept;
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator==(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
+
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator!=(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
+
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator<(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
+
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator<=(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
+
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator>(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
+
+  template <typename T_, std::size_t W_, std::size_t N_, typename E_,
+            std::size_t A_>
+  friend constexpr bool operator>=(
+      const bitpacker<T_, W_, N_, E_, A_>& lhs,
+      const bitpacker<T_, W_, N_, E_, A_>& rhs) noexcept;
 };
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs == rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator==(const bitpacker<T, W, N>& lhs,
-                                 const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return false;
-  }
-
-  return true;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator==(const bitpacker<T, W, N, E, A>& lhs,
+                                 const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) == 0;
 }
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs != rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator!=(const bitpacker<T, W, N>& lhs,
-                                 const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return true;
-  }
-
-  return false;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator!=(const bitpacker<T, W, N, E, A>& lhs,
+                                 const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) != 0;
 }
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs < rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator<(const bitpacker<T, W, N>& lhs,
-                                const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return lhs.data_[i] < rhs.data_[i];
-  }
-
-  return false;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator<(const bitpacker<T, W, N, E, A>& lhs,
+                                const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) < 0;
 }
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs <= rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator<=(const bitpacker<T, W, N>& lhs,
-                                 const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return lhs.data_[i] < rhs.data_[i];
-  }
-
-  return true;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator<=(const bitpacker<T, W, N, E, A>& lhs,
+                                 const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) <= 0;
 }
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs > rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator>(const bitpacker<T, W, N>& lhs,
-                                const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return lhs.data_[i] > rhs.data_[i];
-  }
-
-  return false;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator>(const bitpacker<T, W, N, E, A>& lhs,
+                                const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) > 0;
 }
 
 /// @brief Lexicographically compares two containers
 /// @tparam T I/O value type (signed/unsigned integral or enumeration type)
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
+/// @tparam E Storage policy
+/// @tparam A Storage alignment
 /// @param lhs Left operand
 /// @param rhs Right operand
 /// @return `lhs >= rhs`
-template <typename T, std::size_t W, std::size_t N>
-inline constexpr bool operator>=(const bitpacker<T, W, N>& lhs,
-                                 const bitpacker<T, W, N>& rhs) noexcept {
-  using type_dispatcher = typename bitpacker<T, W, N>::type_dispatcher;
-
-  for (std::size_t i = 0; i < type_dispatcher::word_count; ++i) {
-    if (lhs.data_[i] != rhs.data_[i]) return lhs.data_[i] > rhs.data_[i];
-  }
-
-  return true;
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A>
+inline constexpr bool operator>=(const bitpacker<T, W, N, E, A>& lhs,
+                                 const bitpacker<T, W, N, E, A>& rhs) noexcept {
+  using type_dispatcher = typename bitpacker<T, W, N, E, A>::type_dispatcher;
+
+  return impl::compare_words(lhs.data_, rhs.data_,
+                             type_dispatcher::word_count) >= 0;
 }
 
 /// @brief Signed `bitpacker<T, W, N>` with automatic I/O-type deduction
 /// @tparam W Bit width of packed values
 /// @tparam N Packed-value capacity
-template <std::size_t W, std::size_t N>
-using ibitpacker = bitpacker<impl::fit_signed<W>, W, N>;
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <std::size_t W, std::size_t N, typename E = twos_complement>
+using ibitpacker = bitpacker<impl::fit_signed<W>, W, N, E>;
 
 /// @brief Unsigned `bitpacker<T, W, N>` with automatic I/O-type deduction
 /// @tparam W Bit width of packed values
@@ -660,6 +1212,15 @@ using ibitpacker = bitpacker<impl::fit_signed<W>, W, N>;
 template <std::size_t W, std::size_t N>
 using ubitpacker = bitpacker<impl::fit_unsigned<W>, W, N>;
 
+/// @brief `bitpacker<T, W, N, E>` aligned and padded to whole cache lines
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam N Packed-value capacity
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <typename T, std::size_t W, std::size_t N,
+          typename E = twos_complement>
+using cache_aligned_bitpacker = bitpacker<T, W, N, E, cache_line_size>;
+
 }  // namespace bp3k
 
 #endif  // !_BITPACKER3000_H_
@@ -0,0 +1,162 @@
+#ifndef _BITPACKER3000_ARENA_H_
+#define _BITPACKER3000_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace bp3k {
+
+/// @brief Monotonic bump allocator for heap-backed packers
+///
+/// Allocation bumps a pointer inside the current chunk, `deallocate()` is a
+/// no-op, and `release()` (or destruction) frees everything at once. Every
+/// block is aligned to at least `alignof(std::uintmax_t)`, so packed words
+/// never straddle an alignment boundary. When a chunk runs out, the next
+/// one is twice as large and comes from the global heap; if that fails,
+/// `allocate()` throws `std::bad_alloc` as the `memory_resource` contract
+/// requires (bp3k containers catch it and report a failed allocation).
+/// Without exceptions it returns null, which the containers also accept.
+class packed_arena final : public std::pmr::memory_resource {
+  /// @brief Header placed at the start of each heap chunk
+  struct chunk_header final {
+    chunk_header* next;
+    std::size_t size;
+  };
+
+  /// @brief Minimum alignment of every block
+  static constexpr std::size_t word_align = alignof(std::uintmax_t);
+
+  static constexpr std::size_t header_size =
+      (sizeof(chunk_header) + alignof(std::max_align_t) - 1) &
+      ~(alignof(std::max_align_t) - 1);
+
+  void* initial_buffer_{};
+  std::size_t initial_size_{};
+  chunk_header* chunks_{};
+  std::uintptr_t cursor_{};
+  std::uintptr_t end_{};
+  std::size_t next_chunk_size_;
+  std::size_t bytes_allocated_{};
+
+  /// @brief Rounds an address up to a power-of-two alignment
+  static inline constexpr std::uintptr_t align_up(
+      std::uintptr_t address, std::size_t alignment) noexcept {
+    return (address + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+  }
+
+  /// @brief Starts a new heap chunk able to hold `bytes` at `alignment`
+  /// @return `false` if the global heap is exhausted
+  inline bool grow(std::size_t bytes, std::size_t alignment) noexcept {
+    auto size = this->next_chunk_size_;
+
+    // Doubling would wrap around before reaching such a size
+    if (bytes > (~(std::size_t)0 >> 1) - alignment) return false;
+
+    while (size < bytes + alignment) size <<= 1;
+
+    void* memory = ::operator new(header_size + size, std::nothrow);
+    if (memory == nullptr) return false;
+
+    auto chunk = static_cast<chunk_header*>(memory);
+    chunk->next = this->chunks_;
+    chunk->size = size;
+    this->chunks_ = chunk;
+    this->cursor_ = (std::uintptr_t)memory + header_size;
+    this->end_ = this->cursor_ + size;
+    this->next_chunk_size_ = size << 1;
+    return true;
+  }
+
+  /// @brief Points the cursor back at the caller-supplied buffer
+  inline void reset_cursor() noexcept {
+    this->cursor_ = (std::uintptr_t)this->initial_buffer_;
+    this->end_ = this->cursor_ + this->initial_size_;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (alignment < word_align) alignment = word_align;
+    if (bytes == 0) bytes = 1;
+
+    auto address = align_up(this->cursor_, alignment);
+
+    if (address + bytes > this->end_) {
+      if (!this->grow(bytes, alignment)) {
+#if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+#else
+        return nullptr;
+#endif
+      }
+
+      address = align_up(this->cursor_, alignment);
+    }
+
+    this->cursor_ = address + bytes;
+    this->bytes_allocated_ += bytes;
+    return (void*)address;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ public:
+  /// @brief Default size of the first heap chunk in bytes
+  static constexpr std::size_t default_chunk_size = 4096;
+
+  /// @brief Constructor
+  /// @param chunk_size Size of the first heap chunk in bytes
+  inline explicit packed_arena(
+      std::size_t chunk_size = default_chunk_size) noexcept
+      : next_chunk_size_(chunk_size != 0 ? chunk_size : default_chunk_size) {}
+
+  /// @brief Constructor that serves allocations from `buffer` first
+  /// @param buffer Caller-owned storage (e.g. on the stack)
+  /// @param size Size of `buffer` in bytes
+  /// @param chunk_size Size of the first heap chunk in bytes
+  inline packed_arena(void* buffer, std::size_t size,
+                      std::size_t chunk_size = default_chunk_size) noexcept
+      : initial_buffer_(buffer),
+        initial_size_(size),
+        next_chunk_size_(chunk_size != 0 ? chunk_size : default_chunk_size) {
+    this->reset_cursor();
+  }
+
+  packed_arena(const packed_arena&) = delete;
+  packed_arena& operator=(const packed_arena&) = delete;
+
+  /// @brief Destructor (frees every heap chunk)
+  inline ~packed_arena() override { this->release(); }
+
+  /// @brief Frees every heap chunk and rewinds to the initial buffer
+  ///
+  /// Containers still holding arena storage must not be used afterwards.
+  inline void release() noexcept {
+    while (this->chunks_ != nullptr) {
+      auto next = this->chunks_->next;
+
+      this->next_chunk_size_ = this->chunks_->size;
+      ::operator delete(this->chunks_);
+      this->chunks_ = next;
+    }
+
+    this->bytes_allocated_ = 0;
+    this->reset_cursor();
+  }
+
+  /// @brief Returns the number of bytes handed out since the last release
+  /// @return Byte count (excluding alignment padding)
+  inline std::size_t bytes_allocated() const noexcept {
+    return this->bytes_allocated_;
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_ARENA_H_
@@ -0,0 +1,78 @@
+#ifndef _BITPACKER3000_ATOMIC_H_
+#define _BITPACKER3000_ATOMIC_H_
+
+#include <cstdint>
+
+// Relaxed word-level atomics shared by the concurrent containers. Kept out
+// of bp3k.h so that the core header stays free of <atomic> and C++20.
+#if !defined(__GNUC__) && !defined(__clang__)
+#include <atomic>
+
+#if !defined(__cpp_lib_atomic_ref)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#error "bp3k needs GCC/Clang atomic builtins, std::atomic_ref or MSVC"
+#endif
+#endif
+#endif
+
+namespace bp3k::impl {
+
+/// @brief Atomically replaces a word if it still holds `expected`
+/// @param word Word to update
+/// @param expected Value last seen (updated on failure)
+/// @param desired Replacement
+/// @return `true` if the word was replaced
+inline bool compare_exchange_word(std::uintmax_t* word,
+                                  std::uintmax_t& expected,
+                                  std::uintmax_t desired) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __atomic_compare_exchange_n(word, &expected, desired, true,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#elif defined(__cpp_lib_atomic_ref)
+  return std::atomic_ref<std::uintmax_t>(*word).compare_exchange_weak(
+      expected, desired, std::memory_order_relaxed);
+#else
+  auto seen = (std::uintmax_t)_InterlockedCompareExchange64(
+      (volatile long long*)word, (long long)desired, (long long)expected);
+  if (seen == expected) return true;
+
+  expected = seen;
+  return false;
+#endif
+}
+
+/// @brief Atomically loads a word
+/// @param word Word to read
+/// @return Current value
+inline std::uintmax_t load_word(const std::uintmax_t* word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __atomic_load_n(word, __ATOMIC_RELAXED);
+#elif defined(__cpp_lib_atomic_ref)
+  // atomic_ref<const T> is ill-formed in C++20; the load never writes
+  return std::atomic_ref<std::uintmax_t>(*const_cast<std::uintmax_t*>(word))
+      .load(std::memory_order_relaxed);
+#else
+  // Aligned 64-bit volatile accesses are single instructions on MSVC
+  return *(const volatile std::uintmax_t*)word;
+#endif
+}
+
+/// @brief Atomically stores a word
+/// @param word Word to write
+/// @param value New value
+inline void store_word(std::uintmax_t* word, std::uintmax_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n(word, value, __ATOMIC_RELAXED);
+#elif defined(__cpp_lib_atomic_ref)
+  std::atomic_ref<std::uintmax_t>(*word).store(value,
+                                               std::memory_order_relaxed);
+#else
+  *(volatile std::uintmax_t*)word = value;
+#endif
+}
+
+}  // namespace bp3k::impl
+
+#endif  // !_BITPACKER3000_ATOMIC_H_
@@ -0,0 +1,294 @@
+#ifndef _BITPACKER3000_AUTO_H_
+#define _BITPACKER3000_AUTO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Lane interpretation chosen for a runtime-width buffer
+enum class pack_scheme : std::uint8_t {
+  /// @brief Lanes hold the values as unsigned integers
+  unsigned_bits,
+  /// @brief Lanes hold the values as two's complement integers
+  signed_bits,
+  /// @brief Lanes hold `value - base` as unsigned integers
+  frame_of_reference
+};
+
+/// @brief Result of a minimal-width scan
+/// @tparam T I/O value type (signed/unsigned integral type)
+template <typename T>
+struct width_analysis final {
+  /// @brief Smallest input value
+  T min;
+  /// @brief Largest input value
+  T max;
+  /// @brief Width needed as unsigned lanes (0 if a value is negative)
+  std::size_t unsigned_width;
+  /// @brief Width needed as two's complement lanes (0 for unsigned T)
+  std::size_t signed_width;
+  /// @brief Width needed as offsets from `min`
+  std::size_t for_width;
+  /// @brief Narrowest scheme (ties prefer the cheaper decode)
+  pack_scheme scheme;
+  /// @brief Width of the narrowest scheme
+  std::size_t width;
+};
+
+/// @brief Scans values and computes the minimal width of each scheme
+/// @tparam T I/O value type (signed/unsigned integral type)
+/// @param values Pointer to first input value
+/// @param count Number of input values
+/// @return Analysis (all widths are at least 1)
+template <typename T>
+inline constexpr width_analysis<T> analyze_width(const T* values,
+                                                 std::size_t count) noexcept {
+  static_assert(std::is_integral<T>::value, "T must be an integral type");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+
+  T lo = count != 0 ? values[0] : T{};
+  T hi = lo;
+
+  // Branch-free min/max reduction (vectorizes under -O2/-O3)
+  for (std::size_t i = 1; i < count; ++i) {
+    lo = values[i] < lo ? values[i] : lo;
+    hi = values[i] > hi ? values[i] : hi;
+  }
+
+  width_analysis<T> result{lo, hi, 0, 0, 0, pack_scheme::unsigned_bits, 0};
+
+  auto fit = [](std::size_t w) { return w != 0 ? w : (std::size_t)1; };
+  bool has_negative = false;
+
+  if constexpr (std::is_signed<T>::value) has_negative = lo < 0;
+
+  if (!has_negative)
+    result.unsigned_width = fit(impl::bit_width((unsigned_type)hi));
+
+  if constexpr (std::is_signed<T>::value) {
+    auto magnitude = [](T x) {
+      // Bits of x (or ~x when negative), plus a sign bit
+      return impl::bit_width((unsigned_type)(x < 0 ? (T)~x : x)) + 1;
+    };
+    auto lo_bits = magnitude(lo), hi_bits = magnitude(hi);
+    result.signed_width = lo_bits > hi_bits ? lo_bits : hi_bits;
+  }
+
+  result.for_width = fit(
+      impl::bit_width((unsigned_type)((unsigned_type)hi - (unsigned_type)lo)));
+
+  result.scheme = pack_scheme::signed_bits;
+  result.width = result.signed_width;
+
+  // Unsigned T always qualifies, and its signed_width of 0 means "none"
+  if (result.unsigned_width != 0 &&
+      (result.width == 0 || result.unsigned_width <= result.width)) {
+    result.scheme = pack_scheme::unsigned_bits;
+    result.width = result.unsigned_width;
+  }
+
+  if (result.for_width < result.width) {
+    result.scheme = pack_scheme::frame_of_reference;
+    result.width = result.for_width;
+  }
+
+  return result;
+}
+
+/// @brief Packed array whose width and scheme were chosen at runtime
+/// @tparam T I/O value type (signed/unsigned integral type)
+///
+/// Words use the `bitpacker` layout for width `width()`.
+template <typename T>
+class packed_buffer final {
+  static_assert(std::is_integral<T>::value, "T must be an integral type");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  using lanes = impl::width_dispatcher;
+
+  impl::word_buffer words_{};
+  std::size_t size_{};
+  std::size_t width_{};
+  pack_scheme scheme_{pack_scheme::unsigned_bits};
+  T base_{};
+  bool failed_{};
+
+  /// @brief Maps raw lane bits back to a value
+  inline T decode_bits(std::uintmax_t w_bits) const noexcept {
+    switch (this->scheme_) {
+      case pack_scheme::signed_bits: {
+        auto sign_bit = (std::uintmax_t)1 << (this->width_ - 1);
+        return (T)(unsigned_type)((w_bits ^ sign_bit) - sign_bit);
+      }
+      case pack_scheme::frame_of_reference:
+        return (T)((unsigned_type)this->base_ + (unsigned_type)w_bits);
+      default:
+        return (T)w_bits;
+    }
+  }
+
+  template <typename U>
+  friend packed_buffer<U> pack_auto(
+      const U* values, std::size_t count,
+      std::pmr::memory_resource* resource) noexcept;
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Default constructor (no allocation)
+  packed_buffer() = default;
+
+  /// @brief Constructor (no allocation)
+  /// @param resource Source of word storage (null for the global heap)
+  inline explicit packed_buffer(std::pmr::memory_resource* resource) noexcept
+      : words_(resource) {}
+
+  packed_buffer(const packed_buffer&) = delete;
+  packed_buffer& operator=(const packed_buffer&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Buffer to take ownership from
+  inline packed_buffer(packed_buffer&& other) noexcept { this->swap(other); }
+
+  /// @brief Move assignment
+  /// @param other Buffer to take ownership from
+  /// @return Self reference
+  inline packed_buffer& operator=(packed_buffer&& other) noexcept {
+    packed_buffer tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents of the container with those of `other`
+  /// @param other Buffer to swap with
+  inline void swap(packed_buffer& other) noexcept {
+    this->words_.swap(other.words_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->width_, other.width_);
+    std::swap(this->scheme_, other.scheme_);
+    std::swap(this->base_, other.base_);
+    std::swap(this->failed_, other.failed_);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T at(std::size_t pos) const noexcept {
+    auto w_bits = lanes::extract_value(this->words_.data(), pos, this->width_);
+    return this->decode_bits(w_bits);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T operator[](std::size_t pos) const noexcept { return this->at(pos); }
+
+  /// @brief Decodes all values
+  /// @param out Pointer to `size()` output values
+  inline void decode(T* out) const noexcept {
+    auto n = lanes::per_word(this->width_);
+    auto mask = lanes::value_mask(this->width_);
+    const std::uintmax_t* word_ptr = this->words_.data();
+    std::size_t pos = 0;
+
+    for (; pos < this->size_; ++word_ptr) {
+      auto end = pos + n < this->size_ ? pos + n : this->size_;
+      auto offset = lanes::word_width - this->width_;
+
+      for (; pos < end; ++pos, offset -= this->width_)
+        out[pos] = this->decode_bits((*word_ptr >> offset) & mask);
+    }
+  }
+
+  /// @brief Tells a failed `pack_auto()` apart from an empty input
+  /// @return `false` if allocating the words failed
+  inline bool valid() const noexcept { return !this->failed_; }
+
+  /// @brief Checks if the container has no elements
+  /// @return `true` if the container is empty, `false` otherwise
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of elements in the container
+  /// @return Element count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Returns the chosen bit width
+  /// @return Lane width (0 if empty)
+  inline std::size_t width() const noexcept { return this->width_; }
+
+  /// @brief Returns the chosen lane interpretation
+  /// @return Scheme
+  inline pack_scheme scheme() const noexcept { return this->scheme_; }
+
+  /// @brief Returns the frame-of-reference base
+  /// @return Base (zero unless `scheme()` is `frame_of_reference`)
+  inline T base() const noexcept { return this->base_; }
+
+  /// @brief Fetches address of word storage
+  /// @return Const pointer to first word
+  inline const std::uintmax_t* data() const noexcept {
+    return this->words_.data();
+  }
+
+  /// @brief Returns the number of packed words
+  /// @return Word count
+  inline std::size_t word_count() const noexcept {
+    return this->width_ != 0 ? lanes::words_for(this->size_, this->width_) : 0;
+  }
+
+  /// @brief Returns the source of word storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->words_.resource();
+  }
+};
+
+/// @brief Packs values with the narrowest scheme and width that holds them
+/// @tparam T I/O value type (signed/unsigned integral type)
+/// @param values Pointer to first input value
+/// @param count Number of input values
+/// @param resource Source of word storage (null for the global heap)
+/// @return Packed buffer (empty if `count == 0`; empty and not `valid()`
+/// if allocation failed)
+template <typename T>
+inline packed_buffer<T> pack_auto(
+    const T* values, std::size_t count,
+    std::pmr::memory_resource* resource = nullptr) noexcept {
+  using lanes = impl::width_dispatcher;
+
+  packed_buffer<T> result(resource);
+
+  if (count == 0) return result;
+
+  auto analysis = analyze_width(values, count);
+  auto w = analysis.width;
+  auto base = analysis.scheme == pack_scheme::frame_of_reference
+                  ? analysis.min
+                  : T{};
+
+  if (!result.words_.allocate(lanes::words_for(count, w))) {
+    result.failed_ = true;
+    return result;
+  }
+
+  lanes::pack(values, count, w, result.words_.data(), base);
+
+  result.size_ = count;
+  result.width_ = w;
+  result.scheme_ = analysis.scheme;
+  result.base_ = base;
+  return result;
+}
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_AUTO_H_
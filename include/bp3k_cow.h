@@ -0,0 +1,358 @@
+#ifndef _BITPACKER3000_COW_H_
+#define _BITPACKER3000_COW_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k::impl {
+
+/// @brief Reference-counted block of packed words
+template <std::size_t ChunkWords>
+struct cow_chunk final {
+  std::atomic<std::size_t> refs;
+  std::uintmax_t words[ChunkWords];
+};
+
+/// @brief Page table of shared chunks with the read-only operations of
+/// `cow_packed_array` and its snapshots
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam ChunkWords Number of words per chunk
+/// @tparam E Storage policy
+///
+/// A null page stands for a chunk of zero words, so untouched ranges cost
+/// one pointer.
+template <typename T, std::size_t W, std::size_t ChunkWords, typename E>
+class cow_pages {
+  static_assert(ChunkWords != 0, "ChunkWords must be non-zero");
+
+ protected:
+  using lane = lane_dispatcher<T, W, E>;
+  using chunk = cow_chunk<ChunkWords>;
+
+  heap_array<chunk*> table_{};
+  std::size_t size_{};
+
+  /// @brief Drops one reference to a chunk
+  static inline void release(chunk* c) noexcept {
+    if (c != nullptr && c->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete c;
+  }
+
+  /// @brief Drops every page
+  inline void release_all() noexcept {
+    for (std::size_t i = 0; i < this->table_.capacity(); ++i)
+      release(this->table_.data()[i]);
+  }
+
+  /// @brief Makes `out` share every page of this table
+  /// @return `false` if allocation failed (`out` is left untouched)
+  inline bool share_with(cow_pages& out) const noexcept {
+    heap_array<chunk*> table;
+
+    if (!table.allocate(this->table_.capacity())) return false;
+
+    for (std::size_t i = 0; i < this->table_.capacity(); ++i) {
+      auto c = this->table_.data()[i];
+
+      if (c != nullptr) c->refs.fetch_add(1, std::memory_order_relaxed);
+
+      table.data()[i] = c;
+    }
+
+    out.release_all();
+    out.table_.swap(table);
+    out.size_ = this->size_;
+    return true;
+  }
+
+  inline void swap_pages(cow_pages& other) noexcept {
+    this->table_.swap(other.table_);
+    std::swap(this->size_, other.size_);
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of items per chunk
+  static constexpr std::size_t chunk_items = ChunkWords * lane::per_word;
+
+  cow_pages() = default;
+  cow_pages(const cow_pages&) = delete;
+  cow_pages& operator=(const cow_pages&) = delete;
+
+  /// @brief Destructor (drops every page)
+  inline ~cow_pages() { this->release_all(); }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T at(std::size_t pos) const noexcept {
+    auto c = this->table_.data()[pos / chunk_items];
+    auto local = pos % chunk_items;
+    const std::uintmax_t zero{};
+    const std::uintmax_t* word =
+        c != nullptr ? &c->words[lane::word_index(local)] : &zero;
+
+    return static_cast<T>(lane::extract_value(word, lane::item_offset(local)));
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T operator[](std::size_t pos) const noexcept { return this->at(pos); }
+
+  /// @brief Decodes consecutive items
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  inline void unpack(std::size_t pos, std::size_t count,
+                     T* out) const noexcept {
+    while (count != 0) {
+      auto c = this->table_.data()[pos / chunk_items];
+      auto local = pos % chunk_items;
+      auto n = chunk_items - local < count ? chunk_items - local : count;
+
+      if (c != nullptr) {
+        lane::unpack(c->words, local, n, out);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) out[i] = this->at(pos + i);
+      }
+
+      pos += n;
+      out += n;
+      count -= n;
+    }
+  }
+
+  /// @brief Visits all items in order
+  /// @tparam F Callable as `f(T)`
+  /// @param f Visitor
+  template <typename F>
+  inline void for_each(F&& f) const {
+    for (std::size_t first = 0; first < this->size_; first += chunk_items) {
+      auto c = this->table_.data()[first / chunk_items];
+      auto n = this->size_ - first < chunk_items ? this->size_ - first
+                                                 : chunk_items;
+
+      if (c != nullptr) {
+        lane::for_each(c->words, 0, n, f);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) f(this->at(first + i));
+      }
+    }
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return Element count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Checks if the container has no elements
+  /// @return `true` if the container is empty, `false` otherwise
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of pages
+  /// @return Chunk count (including unallocated pages)
+  inline std::size_t chunk_count() const noexcept {
+    return this->table_.capacity();
+  }
+};
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Read-only point-in-time view of a `cow_packed_array`
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam ChunkWords Number of words per chunk
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// Holds references to the chunks that existed when it was taken; later
+/// writes to the array copy those chunks instead of changing them. A
+/// snapshot can be read and destroyed from any thread.
+template <typename T, std::size_t W, std::size_t ChunkWords = 512,
+          typename E = twos_complement>
+class cow_snapshot final : public impl::cow_pages<T, W, ChunkWords, E> {
+ public:
+  /// @brief Default constructor (empty view)
+  cow_snapshot() = default;
+
+  /// @brief Move constructor
+  /// @param other Snapshot to take ownership from
+  inline cow_snapshot(cow_snapshot&& other) noexcept { this->swap(other); }
+
+  /// @brief Move assignment
+  /// @param other Snapshot to take ownership from
+  /// @return Self reference
+  inline cow_snapshot& operator=(cow_snapshot&& other) noexcept {
+    cow_snapshot tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents with those of `other`
+  /// @param other Snapshot to swap with
+  inline void swap(cow_snapshot& other) noexcept { this->swap_pages(other); }
+};
+
+/// @brief Chunked packed array whose snapshots share unchanged chunks
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam ChunkWords Number of words per chunk
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// Items live in reference-counted chunks of `ChunkWords` words (`bitpacker`
+/// layout) reached through a page table. `snapshot()` copies the page table
+/// and bumps each chunk's count, so it costs O(chunks) pointer copies;
+/// a write duplicates its chunk only while some snapshot still shares it.
+/// The array has a single writer: writes and `snapshot()` must not race
+/// with each other, while snapshots may be used concurrently.
+template <typename T, std::size_t W, std::size_t ChunkWords = 512,
+          typename E = twos_complement>
+class cow_packed_array final : public impl::cow_pages<T, W, ChunkWords, E> {
+  using pages = impl::cow_pages<T, W, ChunkWords, E>;
+  using typename pages::chunk;
+  using typename pages::lane;
+  using unsigned_type = typename lane::unsigned_type;
+
+  /// @brief Returns a chunk that only this array references
+  /// @return Pointer to the chunk, or null if allocation failed
+  inline chunk* writable(std::size_t index) noexcept {
+    auto& slot = this->table_.data()[index];
+    auto c = slot;
+
+    if (c != nullptr && c->refs.load(std::memory_order_acquire) == 1)
+      return c;
+
+    auto copy = new (std::nothrow) chunk();
+    if (copy == nullptr) return nullptr;
+
+    copy->refs.store(1, std::memory_order_relaxed);
+
+    if (c != nullptr) {
+      for (std::size_t i = 0; i < ChunkWords; ++i) copy->words[i] = c->words[i];
+    }
+
+    pages::release(c);
+    slot = copy;
+    return copy;
+  }
+
+ public:
+  /// @brief Read-only view type
+  using snapshot_type = cow_snapshot<T, W, ChunkWords, E>;
+
+  /// @brief Default constructor (empty, no allocation)
+  cow_packed_array() = default;
+
+  /// @brief Move constructor
+  /// @param other Array to take ownership from
+  inline cow_packed_array(cow_packed_array&& other) noexcept {
+    this->swap(other);
+  }
+
+  /// @brief Move assignment
+  /// @param other Array to take ownership from
+  /// @return Self reference
+  inline cow_packed_array& operator=(cow_packed_array&& other) noexcept {
+    cow_packed_array tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents with those of `other`
+  /// @param other Array to swap with
+  inline void swap(cow_packed_array& other) noexcept {
+    this->swap_pages(other);
+  }
+
+  /// @brief Changes the number of items (new items are zero)
+  /// @param count New item count
+  /// @return `false` if allocation failed (the array is left untouched)
+  inline bool resize(std::size_t count) noexcept {
+    auto chunks = (count + pages::chunk_items - 1) / pages::chunk_items;
+    auto tail = count % pages::chunk_items;
+    auto kept = chunks < this->chunk_count() ? chunks : this->chunk_count();
+
+    // Items past the new end of a shared last chunk must read as zero later
+    if (count < this->size_ && tail != 0 &&
+        this->table_.data()[chunks - 1] != nullptr &&
+        this->writable(chunks - 1) == nullptr)
+      return false;
+
+    impl::heap_array<chunk*> table;
+
+    if (!table.allocate(chunks)) return false;
+
+    for (std::size_t i = 0; i < kept; ++i) {
+      table.data()[i] = this->table_.data()[i];
+      this->table_.data()[i] = nullptr;
+    }
+
+    auto last = chunks != 0 ? table.data()[chunks - 1] : nullptr;
+
+    if (count < this->size_ && tail != 0 && last != nullptr) {
+      auto words = last->words;
+      auto end = this->size_ - (chunks - 1) * pages::chunk_items;
+
+      if (end > pages::chunk_items) end = pages::chunk_items;
+
+      for (auto i = tail; i < end; ++i)
+        lane::embed_value(&words[lane::word_index(i)], lane::item_offset(i),
+                          0);
+    }
+
+    this->release_all();
+    this->table_.swap(table);
+    this->size_ = count;
+    return true;
+  }
+
+  /// @brief Stores a value
+  /// @param pos Index of item
+  /// @param x Value
+  /// @return `false` if copying the chunk failed (the array is untouched)
+  inline bool set(std::size_t pos, T x) noexcept {
+    auto c = this->writable(pos / pages::chunk_items);
+    if (c == nullptr) return false;
+
+    auto local = pos % pages::chunk_items;
+    lane::embed_value(&c->words[lane::word_index(local)],
+                      lane::item_offset(local), static_cast<unsigned_type>(x));
+    return true;
+  }
+
+  /// @brief Takes a point-in-time view
+  /// @param out Destination (its previous view is dropped)
+  /// @return `false` if allocation failed (`out` is left untouched)
+  inline bool snapshot(snapshot_type& out) const noexcept {
+    return this->share_with(out);
+  }
+
+  /// @brief Counts chunks currently shared with a snapshot
+  /// @return Number of chunks that the next write to them would copy
+  inline std::size_t shared_chunks() const noexcept {
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < this->chunk_count(); ++i) {
+      auto c = this->table_.data()[i];
+
+      if (c != nullptr && c->refs.load(std::memory_order_acquire) > 1)
+        ++count;
+    }
+
+    return count;
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_COW_H_
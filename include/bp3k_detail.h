@@ -0,0 +1,332 @@
+#ifndef _BITPACKER3000_DETAIL_H_
+#define _BITPACKER3000_DETAIL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+// Heap storage, bit counting, hashing and runtime-width packing shared by
+// the extension headers. Kept out of bp3k.h, which needs none of them.
+namespace bp3k::impl {
+
+/// @brief Heap-allocated, zero-initialized array (never throws)
+/// @tparam E Trivially copyable element type
+///
+/// Storage comes from `std::pmr::memory_resource` when one is supplied and
+/// from the global heap otherwise. A resource that throws on exhaustion is
+/// reported as a failed allocation like a null return.
+template <typename E>
+class heap_array final {
+  static_assert(std::is_trivially_copyable<E>::value,
+                "E must be trivially copyable");
+
+  /// @brief Pointer to first element
+  E* items_{};
+  /// @brief Number of allocated elements
+  std::size_t capacity_{};
+  /// @brief Source of storage (null for the global heap)
+  std::pmr::memory_resource* resource_{};
+
+  /// @brief Returns storage to where it came from
+  inline void release() noexcept {
+    if (this->resource_ == nullptr) {
+      delete[] this->items_;
+    } else if (this->items_ != nullptr) {
+      this->resource_->deallocate(this->items_, this->capacity_ * sizeof(E),
+                                  alignof(E));
+    }
+  }
+
+  /// @brief Obtains zeroed storage for `count` elements
+  /// @return Pointer to storage, or null if allocation failed
+  inline E* acquire(std::size_t count) const noexcept {
+    if (this->resource_ == nullptr) return new (std::nothrow) E[count]();
+
+    void* bytes = nullptr;
+
+#if defined(__cpp_exceptions)
+    try {
+      bytes = this->resource_->allocate(count * sizeof(E), alignof(E));
+    } catch (...) {
+      return nullptr;
+    }
+#else
+    bytes = this->resource_->allocate(count * sizeof(E), alignof(E));
+#endif
+
+    if (bytes == nullptr) return nullptr;
+
+    E* items = static_cast<E*>(bytes);
+
+    for (std::size_t i = 0; i < count; ++i) new (&items[i]) E();
+
+    return items;
+  }
+
+ public:
+  /// @brief Default constructor (no allocation, global heap)
+  heap_array() = default;
+
+  /// @brief Constructor (no allocation)
+  /// @param resource Source of storage (null for the global heap)
+  inline explicit heap_array(std::pmr::memory_resource* resource) noexcept
+      : resource_(resource) {}
+
+  heap_array(const heap_array&) = delete;
+  heap_array& operator=(const heap_array&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Array to take ownership from
+  inline heap_array(heap_array&& other) noexcept
+      : items_(other.items_),
+        capacity_(other.capacity_),
+        resource_(other.resource_) {
+    other.items_ = nullptr;
+    other.capacity_ = 0;
+  }
+
+  /// @brief Move assignment
+  /// @param other Array to take ownership from
+  /// @return Self reference
+  inline heap_array& operator=(heap_array&& other) noexcept {
+    if (this != &other) {
+      this->release();
+      this->items_ = other.items_;
+      this->capacity_ = other.capacity_;
+      this->resource_ = other.resource_;
+      other.items_ = nullptr;
+      other.capacity_ = 0;
+    }
+
+    return *this;
+  }
+
+  /// @brief Destructor
+  inline ~heap_array() { this->release(); }
+
+  /// @brief Replaces contents with `count` zeroed elements
+  /// @param count Number of elements to allocate
+  /// @return `false` if allocation failed (contents are left untouched)
+  inline bool allocate(std::size_t count) noexcept {
+    E* items = nullptr;
+
+    if (count != 0) {
+      items = this->acquire(count);
+      if (items == nullptr) return false;
+    }
+
+    this->release();
+    this->items_ = items;
+    this->capacity_ = count;
+    return true;
+  }
+
+  /// @brief Copies the leading elements of another array
+  /// @param other Source array
+  /// @param count Number of elements to copy (clamped to both capacities)
+  inline void copy_from(const heap_array& other, std::size_t count) noexcept {
+    if (count > this->capacity_) count = this->capacity_;
+    if (count > other.capacity_) count = other.capacity_;
+
+    for (std::size_t i = 0; i < count; ++i) this->items_[i] = other.items_[i];
+  }
+
+  /// @brief Exchanges storage with another array
+  /// @param other Array to swap with
+  inline void swap(heap_array& other) noexcept {
+    auto items = this->items_;
+    auto capacity = this->capacity_;
+    auto resource = this->resource_;
+
+    this->items_ = other.items_;
+    this->capacity_ = other.capacity_;
+    this->resource_ = other.resource_;
+    other.items_ = items;
+    other.capacity_ = capacity;
+    other.resource_ = resource;
+  }
+
+  /// @brief Fetches address of storage
+  /// @return Pointer to first element
+  inline E* data() noexcept { return this->items_; }
+
+  /// @brief Fetches address of storage
+  /// @return Const pointer to first element
+  inline const E* data() const noexcept { return this->items_; }
+
+  /// @brief Returns the number of allocated elements
+  /// @return Element capacity
+  inline std::size_t capacity() const noexcept { return this->capacity_; }
+
+  /// @brief Returns the source of storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->resource_;
+  }
+};
+
+/// @brief Heap-allocated, zero-initialized word storage (never throws)
+using word_buffer = heap_array<std::uintmax_t>;
+
+/// @brief Computes the number of significant bits in a word
+/// @param x Word
+/// @return Position of the highest set bit plus one (0 for `x == 0`)
+inline constexpr std::size_t bit_width(std::uintmax_t x) noexcept {
+  std::size_t width = 0;
+
+  for (std::size_t shift = (sizeof(std::uintmax_t) << 2); shift != 0;
+       shift >>= 1) {
+    if (x >> shift) {
+      x >>= shift;
+      width += shift;
+    }
+  }
+
+  return width + (std::size_t)(x != 0);
+}
+
+/// @brief Counts set bits in a word
+/// @param x Word
+/// @return Number of set bits
+inline constexpr std::size_t popcount(std::uintmax_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return (std::size_t)__builtin_popcountll(x);
+#else
+  std::size_t count = 0;
+
+  for (; x != 0; x &= x - 1) ++count;
+
+  return count;
+#endif
+}
+
+/// @brief Scrambles a 64-bit key (SplitMix64 finalizer)
+/// @param x Key
+/// @return Hash
+inline constexpr std::uint64_t mix64(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/// @brief Dispatches unsigned bit-packing operations for a runtime width
+///
+/// Lanes use the same layout as `lane_dispatcher` (MSB-first, no item
+/// straddles two words). Valid widths are 1 through the word width.
+struct width_dispatcher final {
+  static constexpr std::size_t word_width = sizeof(std::uintmax_t) << 3;
+
+  /// @brief Computes the lane mask for width `w`
+  /// @param w Bit width
+  /// @return Mask of the `w` low bits
+  static inline constexpr std::uintmax_t value_mask(std::size_t w) noexcept {
+    return ~(std::uintmax_t)0 >> (word_width - w);
+  }
+
+  /// @brief Computes number of items per word
+  /// @param w Bit width
+  /// @return Items per word
+  static inline constexpr std::size_t per_word(std::size_t w) noexcept {
+    return word_width / w;
+  }
+
+  /// @brief Computes number of words needed to hold `item_count` items
+  /// @param item_count Number of packed items
+  /// @param w Bit width
+  /// @return Word count
+  static inline constexpr std::size_t words_for(std::size_t item_count,
+                                                std::size_t w) noexcept {
+    auto n = per_word(w);
+    return (item_count + n - 1) / n;
+  }
+
+  /// @brief Unpacks an item
+  /// @param word_ptr Pointer to first word
+  /// @param pos Index of item
+  /// @param w Bit width
+  /// @return Unpacked (zero-extended) bits
+  static inline constexpr std::uintmax_t extract_value(
+      const std::uintmax_t* word_ptr, std::size_t pos, std::size_t w) noexcept {
+    auto n = per_word(w);
+    auto offset = word_width - w - (pos % n) * w;
+    return (word_ptr[pos / n] >> offset) & value_mask(w);
+  }
+
+  /// @brief Packs an item
+  /// @param word_ptr Pointer to first word
+  /// @param pos Index of item
+  /// @param w Bit width
+  /// @param value Value to embed (truncated to `w` bits)
+  static inline constexpr void embed_value(std::uintmax_t* word_ptr,
+                                           std::size_t pos, std::size_t w,
+                                           std::uintmax_t value) noexcept {
+    auto n = per_word(w);
+    auto offset = word_width - w - (pos % n) * w;
+    auto mask = value_mask(w);
+
+    word_ptr[pos / n] &= ~(mask << offset);
+    word_ptr[pos / n] |= (value & mask) << offset;
+  }
+
+  /// @brief Packs consecutive items into whole words
+  /// @tparam U Integral input type
+  /// @param values Pointer to first input value
+  /// @param count Number of values
+  /// @param w Bit width
+  /// @param word_ptr Pointer to first output word (`words_for(count, w)`)
+  /// @param base Subtracted (modulo 2^bits of U) from every value
+  template <typename U>
+  static inline constexpr void pack(const U* values, std::size_t count,
+                                    std::size_t w, std::uintmax_t* word_ptr,
+                                    U base = U{}) noexcept {
+    using unsigned_type = typename std::make_unsigned<U>::type;
+
+    auto n = per_word(w);
+    auto mask = value_mask(w);
+    std::size_t pos = 0;
+
+    for (; pos < count; ++word_ptr) {
+      std::uintmax_t word{};
+      auto end = pos + n < count ? pos + n : count;
+
+      for (auto offset = word_width - w; pos < end; ++pos, offset -= w) {
+        auto bits = (unsigned_type)((unsigned_type)values[pos] -
+                                    (unsigned_type)base);
+        word |= ((std::uintmax_t)bits & mask) << offset;
+      }
+
+      *word_ptr = word;
+    }
+  }
+
+  /// @brief Unpacks consecutive items from whole words
+  /// @tparam U Unsigned output type
+  /// @param word_ptr Pointer to first input word
+  /// @param count Number of values
+  /// @param w Bit width
+  /// @param out Pointer to first output value
+  template <typename U>
+  static inline constexpr void unpack(const std::uintmax_t* word_ptr,
+                                      std::size_t count, std::size_t w,
+                                      U* out) noexcept {
+    auto n = per_word(w);
+    auto mask = value_mask(w);
+    std::size_t pos = 0;
+
+    for (; pos < count; ++word_ptr) {
+      auto word = *word_ptr;
+      auto end = pos + n < count ? pos + n : count;
+
+      for (auto offset = word_width - w; pos < end; ++pos, offset -= w)
+        out[pos] = (U)((word >> offset) & mask);
+    }
+  }
+};
+
+}  // namespace bp3k::impl
+
+#endif  // !_BITPACKER3000_DETAIL_H_
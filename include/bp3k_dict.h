@@ -0,0 +1,225 @@
+#ifndef _BITPACKER3000_DICT_H_
+#define _BITPACKER3000_DICT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k::impl {
+
+/// @brief Values of a dictionary sorted by key, with their codes
+/// @tparam T Key type (integral or enumeration type)
+/// @tparam Count Number of keys
+template <typename T, std::size_t Count>
+struct dictionary_index final {
+  using integral_type = impl_type<T>;
+
+  /// @brief Keys in ascending order
+  integral_type keys[Count];
+  /// @brief `codes[i]` is the code of `keys[i]`
+  std::size_t codes[Count];
+
+  /// @brief Sorts the keys (insertion sort, compile time only)
+  /// @param values Keys in code order
+  inline constexpr explicit dictionary_index(const T* values) noexcept
+      : keys{}, codes{} {
+    for (std::size_t i = 0; i < Count; ++i) {
+      auto key = static_cast<integral_type>(values[i]);
+      auto j = i;
+
+      for (; j > 0 && this->keys[j - 1] > key; --j) {
+        this->keys[j] = this->keys[j - 1];
+        this->codes[j] = this->codes[j - 1];
+      }
+
+      this->keys[j] = key;
+      this->codes[j] = i;
+    }
+  }
+
+  /// @brief Checks that no key appears twice
+  /// @return `true` if all keys are distinct
+  inline constexpr bool unique() const noexcept {
+    for (std::size_t i = 1; i < Count; ++i) {
+      if (this->keys[i - 1] == this->keys[i]) return false;
+    }
+
+    return true;
+  }
+
+  /// @brief Finds the code of a key
+  /// @param x Key
+  /// @return Code, or `Count` if `x` is not a key
+  inline constexpr std::size_t find(T x) const noexcept {
+    auto key = static_cast<integral_type>(x);
+    std::size_t lo = 0, hi = Count;
+
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+
+      if (this->keys[mid] < key)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    return lo < Count && this->keys[lo] == key ? this->codes[lo] : Count;
+  }
+};
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Compile-time list of the values a `dict_packer` can hold
+/// @tparam T Value type (integral or enumeration type)
+/// @tparam Values Distinct values; a value's position is its code
+template <typename T, T... Values>
+struct enum_dictionary final {
+  static_assert(sizeof...(Values) != 0, "dictionary must not be empty");
+
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of values
+  static constexpr std::size_t size = sizeof...(Values);
+
+  /// @brief Bits per code (at least 1)
+  static constexpr std::size_t width =
+      size > 1 ? impl::bit_width(size - 1) : 1;
+
+  /// @brief Narrowest unsigned type holding a code
+  using code_type = impl::fit_unsigned<width>;
+
+  /// @brief Decode table (`values[code]`)
+  static constexpr T values[size] = {Values...};
+
+ private:
+  static constexpr impl::dictionary_index<T, size> index_{values};
+
+  static_assert(index_.unique(), "dictionary values must be distinct");
+
+ public:
+  /// @brief Checks if a value is in the dictionary
+  /// @param x Value
+  /// @return `true` if `x` has a code
+  static inline constexpr bool contains(T x) noexcept {
+    return index_.find(x) != size;
+  }
+
+  /// @brief Maps a value to its code
+  /// @param x Value
+  /// @param code Output code (unchanged if `x` is not in the dictionary)
+  /// @return `false` if `x` is not in the dictionary
+  static inline constexpr bool encode(T x, code_type& code) noexcept {
+    auto found = index_.find(x);
+
+    if (found == size) return false;
+
+    code = static_cast<code_type>(found);
+    return true;
+  }
+
+  /// @brief Maps a code back to its value
+  /// @param code Code (must be below `size`)
+  /// @return Value
+  static inline constexpr T decode(code_type code) noexcept {
+    return values[code];
+  }
+};
+
+/// @brief Packed array of dictionary codes
+/// @tparam Dict `enum_dictionary<T, Values...>`
+/// @tparam N Packed-value capacity
+///
+/// Sparse enumerators such as `{0, 100, 1000, -5}` need only
+/// `Dict::width` bits per element instead of the width of their values.
+/// Values outside the dictionary are rejected. A default-constructed
+/// array holds code 0 (the first dictionary value) everywhere.
+template <typename Dict, std::size_t N>
+class dict_packer final {
+  using T = typename Dict::value_type;
+  using code_type = typename Dict::code_type;
+  using code_packer = bitpacker<code_type, Dict::width, N>;
+
+  code_packer codes_{};
+
+ public:
+  /// @brief Dictionary value type
+  using value_type = T;
+
+  /// @brief Dictionary
+  using dictionary_type = Dict;
+
+  /// @brief Bits per element
+  static constexpr std::size_t width = Dict::width;
+
+  /// @brief Default constructor (every element is `Dict::values[0]`)
+  dict_packer() = default;
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T at(std::size_t pos) const noexcept {
+    return Dict::decode(this->codes_[pos]);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T operator[](std::size_t pos) const noexcept {
+    return this->at(pos);
+  }
+
+  /// @brief Stores a value
+  /// @param pos Index of item
+  /// @param x Value
+  /// @return `false` if `x` is not in the dictionary (nothing is modified)
+  inline constexpr bool set(std::size_t pos, T x) noexcept {
+    code_type code{};
+
+    if (!Dict::encode(x, code)) return false;
+
+    this->codes_[pos] = code;
+    return true;
+  }
+
+  /// @brief Assigns `x` to all elements
+  /// @param x Fill value
+  /// @return `false` if `x` is not in the dictionary (nothing is modified)
+  inline constexpr bool fill(T x) noexcept {
+    code_type code{};
+
+    if (!Dict::encode(x, code)) return false;
+
+    this->codes_.fill(code);
+    return true;
+  }
+
+  /// @brief Decodes consecutive items
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  inline constexpr void unpack(std::size_t pos, std::size_t count,
+                               T* out) const noexcept {
+    impl::lane_dispatcher<code_type, Dict::width>::for_each(
+        this->codes_.data(), pos, count,
+        [&out](code_type code) { *out++ = Dict::decode(code); });
+  }
+
+  /// @brief Fetches the code array
+  /// @return Reference to the packed codes
+  inline constexpr const code_packer& codes() const noexcept {
+    return this->codes_;
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return N
+  inline constexpr std::size_t size() const noexcept { return N; }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_DICT_H_
@@ -0,0 +1,349 @@
+#ifndef _BITPACKER3000_ELIAS_FANO_H_
+#define _BITPACKER3000_ELIAS_FANO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Elias–Fano encoding of a non-decreasing sequence
+/// @tparam T Unsigned value type
+///
+/// With `n` values up to `u`, each value keeps its `l = floor(log2(u / n))`
+/// low bits in a packed array (`bitpacker` lane layout) and its high bits
+/// in unary: value `i` sets bit `(x >> l) + i` of a bitmap of about `2n`
+/// bits. Positions of every `select_rate`-th one and zero are sampled, so
+/// `operator[]` and `next_geq()` start from a sample and finish with a few
+/// popcounts.
+template <typename T = std::uint64_t>
+class elias_fano final {
+  static_assert(std::is_unsigned<T>::value, "T must be an unsigned type");
+
+  using lanes = impl::width_dispatcher;
+
+  static constexpr std::size_t word_width = lanes::word_width;
+
+ public:
+  /// @brief Number of ones (and zeros) between two select samples
+  static constexpr std::size_t select_rate = 256;
+
+ private:
+  impl::word_buffer low_{};
+  impl::word_buffer high_{};
+  impl::heap_array<std::size_t> ones_{};
+  impl::heap_array<std::size_t> zeros_{};
+  std::size_t size_{};
+  std::size_t low_width_{};
+  std::size_t high_bits_{};
+  std::size_t zero_count_{};
+
+  /// @brief Finds the first set bit at or after `pos`
+  inline std::size_t next_one(std::size_t pos) const noexcept {
+    const std::uintmax_t* high = this->high_.data();
+    auto w = pos / word_width;
+    auto word = high[w] & (~(std::uintmax_t)0 << (pos % word_width));
+
+    while (word == 0) word = high[++w];
+
+    return w * word_width + impl::popcount((word & (0 - word)) - 1);
+  }
+
+  /// @brief Combines the high part at bit `pos` with the low bits of `i`
+  inline T value_at(std::size_t i, std::size_t pos) const noexcept {
+    auto high = (std::uintmax_t)(pos - i) << this->low_width_;
+    auto low = this->low_width_ != 0
+                   ? lanes::extract_value(this->low_.data(), i,
+                                          this->low_width_)
+                   : 0;
+
+    return (T)(high | low);
+  }
+
+  /// @brief Finds the k-th (0-based) set bit of a word
+  static inline std::size_t select_in_word(std::uintmax_t word,
+                                           std::size_t k) noexcept {
+    for (; k != 0; --k) word &= word - 1;
+
+    return impl::popcount((word & (0 - word)) - 1);
+  }
+
+  /// @brief Finds the k-th (0-based) one (or zero) of the high bitmap
+  template <bool Ones>
+  inline std::size_t select(std::size_t k) const noexcept {
+    const std::size_t* samples =
+        Ones ? this->ones_.data() : this->zeros_.data();
+    const std::uintmax_t* high = this->high_.data();
+    auto pos = samples[k / select_rate];
+    auto rest = k % select_rate;
+    auto w = pos / word_width;
+    auto word = Ones ? high[w] : ~high[w];
+
+    // Skip bits before the sampled position
+    word &= ~(std::uintmax_t)0 << (pos % word_width);
+
+    for (;;) {
+      auto count = impl::popcount(word);
+
+      if (rest < count) return w * word_width + select_in_word(word, rest);
+
+      rest -= count;
+      ++w;
+      word = Ones ? high[w] : ~high[w];
+    }
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Forward iterator over decoded values
+  class const_iterator final {
+    friend class elias_fano;
+
+    const elias_fano* owner_{};
+    std::size_t index_{};
+    /// @brief Bit position of the current element in the high bitmap
+    std::size_t pos_{};
+
+    inline const_iterator(const elias_fano* owner, std::size_t index,
+                          std::size_t pos) noexcept
+        : owner_(owner), index_(index), pos_(pos) {}
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = T;
+
+    const_iterator() = default;
+
+    /// @brief Decodes the current value
+    /// @return Value
+    inline T operator*() const noexcept {
+      return this->owner_->value_at(this->index_, this->pos_);
+    }
+
+    /// @brief Advances to the next value
+    /// @return Self reference
+    inline const_iterator& operator++() noexcept {
+      if (++this->index_ < this->owner_->size_)
+        this->pos_ = this->owner_->next_one(this->pos_ + 1);
+
+      return *this;
+    }
+
+    /// @brief Advances to the next value
+    /// @return Copy before advancing
+    inline const_iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    /// @brief Returns the index of the current value
+    /// @return Index (`size()` at the end)
+    inline std::size_t index() const noexcept { return this->index_; }
+
+    inline bool operator==(const const_iterator& other) const noexcept {
+      return this->index_ == other.index_;
+    }
+
+    inline bool operator!=(const const_iterator& other) const noexcept {
+      return this->index_ != other.index_;
+    }
+  };
+
+  /// @brief Default constructor (empty sequence)
+  elias_fano() = default;
+
+  /// @brief Constructor (empty sequence, no allocation)
+  /// @param resource Source of storage (null for the global heap)
+  inline explicit elias_fano(std::pmr::memory_resource* resource) noexcept
+      : low_(resource), high_(resource), ones_(resource), zeros_(resource) {}
+
+  elias_fano(const elias_fano&) = delete;
+  elias_fano& operator=(const elias_fano&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Sequence to take ownership from
+  inline elias_fano(elias_fano&& other) noexcept { this->swap(other); }
+
+  /// @brief Move assignment
+  /// @param other Sequence to take ownership from
+  /// @return Self reference
+  inline elias_fano& operator=(elias_fano&& other) noexcept {
+    elias_fano tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents with those of `other`
+  /// @param other Sequence to swap with
+  inline void swap(elias_fano& other) noexcept {
+    this->low_.swap(other.low_);
+    this->high_.swap(other.high_);
+    this->ones_.swap(other.ones_);
+    this->zeros_.swap(other.zeros_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->low_width_, other.low_width_);
+    std::swap(this->high_bits_, other.high_bits_);
+    std::swap(this->zero_count_, other.zero_count_);
+  }
+
+  /// @brief Encodes a sequence, replacing the current contents
+  /// @param values Pointer to first value
+  /// @param count Number of values
+  /// @return `false` if the values decrease or allocation failed (contents
+  /// are left untouched)
+  inline bool encode(const T* values, std::size_t count) noexcept {
+    for (std::size_t i = 1; i < count; ++i) {
+      if (values[i] < values[i - 1]) return false;
+    }
+
+    elias_fano next(this->resource());
+
+    if (count == 0) {
+      this->swap(next);
+      return true;
+    }
+
+    auto max = (std::uintmax_t)values[count - 1];
+    auto ratio = max / count;
+    auto l = ratio != 0 ? impl::bit_width(ratio) - 1 : 0;
+    auto zero_count = (std::size_t)(max >> l) + 1;
+    auto high_bits = count + zero_count;
+    auto high_words = (high_bits + word_width - 1) / word_width;
+
+    if ((l != 0 && !next.low_.allocate(lanes::words_for(count, l))) ||
+        !next.high_.allocate(high_words) ||
+        !next.ones_.allocate((count + select_rate - 1) / select_rate) ||
+        !next.zeros_.allocate((zero_count + select_rate - 1) / select_rate))
+      return false;
+
+    std::uintmax_t* low = next.low_.data();
+    std::uintmax_t* high = next.high_.data();
+    std::size_t* ones = next.ones_.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+      auto x = (std::uintmax_t)values[i];
+      auto pos = (std::size_t)(x >> l) + i;
+
+      if (l != 0) lanes::embed_value(low, i, l, x);
+
+      high[pos / word_width] |= (std::uintmax_t)1 << (pos % word_width);
+
+      if (i % select_rate == 0) ones[i / select_rate] = pos;
+    }
+
+    std::size_t* zeros = next.zeros_.data();
+
+    for (std::size_t pos = 0, k = 0; pos < high_bits; ++pos) {
+      if (!((high[pos / word_width] >> (pos % word_width)) & 1)) {
+        if (k % select_rate == 0) zeros[k / select_rate] = pos;
+        ++k;
+      }
+    }
+
+    next.size_ = count;
+    next.low_width_ = l;
+    next.high_bits_ = high_bits;
+    next.zero_count_ = zero_count;
+    this->swap(next);
+    return true;
+  }
+
+  /// @brief Decodes a value
+  /// @param i Index of value
+  /// @return Value
+  inline T operator[](std::size_t i) const noexcept {
+    return this->value_at(i, this->select<true>(i));
+  }
+
+  /// @brief Decodes a value
+  /// @param i Index of value
+  /// @return Value
+  inline T at(std::size_t i) const noexcept { return (*this)[i]; }
+
+  /// @brief Finds the first value not less than `x`
+  /// @param x Lower bound
+  /// @return Iterator to that value, or `end()` if every value is below `x`
+  inline const_iterator next_geq(T x) const noexcept {
+    auto h = (std::size_t)((std::uintmax_t)x >> this->low_width_);
+
+    if (this->size_ == 0 || h >= this->zero_count_) return this->end();
+
+    // Values with high part below h come before the h-th zero
+    std::size_t index = 0, pos = 0;
+
+    if (h != 0) {
+      auto zero = this->select<false>(h - 1);
+      index = zero - (h - 1);
+      pos = zero + 1;
+    }
+
+    if (index == this->size_) return this->end();
+
+    const_iterator it(this, index, this->next_one(pos));
+
+    while (it != this->end() && *it < x) ++it;
+
+    return it;
+  }
+
+  /// @brief Returns an iterator to the first value
+  /// @return Iterator
+  inline const_iterator begin() const noexcept {
+    if (this->size_ == 0) return this->end();
+
+    return const_iterator(this, 0, this->next_one(0));
+  }
+
+  /// @brief Returns the past-the-end iterator
+  /// @return Iterator
+  inline const_iterator end() const noexcept {
+    return const_iterator(this, this->size_, this->high_bits_);
+  }
+
+  /// @brief Returns the number of values
+  /// @return Value count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Checks if the sequence is empty
+  /// @return `true` if there are no values
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of low bits per value
+  /// @return Low width
+  inline std::size_t low_width() const noexcept { return this->low_width_; }
+
+  /// @brief Returns the heap footprint
+  /// @return Byte count
+  inline std::size_t bytes_used() const noexcept {
+    auto low_words = this->low_width_ != 0
+                         ? lanes::words_for(this->size_, this->low_width_)
+                         : 0;
+    auto high_words = (this->high_bits_ + word_width - 1) / word_width;
+
+    return (low_words + high_words) * sizeof(std::uintmax_t) +
+           (this->ones_.capacity() + this->zeros_.capacity()) *
+               sizeof(std::size_t);
+  }
+
+  /// @brief Returns the source of storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->high_.resource();
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_ELIAS_FANO_H_
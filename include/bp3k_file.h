@@ -0,0 +1,329 @@
+#ifndef _BITPACKER3000_FILE_H_
+#define _BITPACKER3000_FILE_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Background file writer for packed chunks (POSIX)
+///
+/// Bytes are copied into a ring of aligned buffers; each full buffer is
+/// handed to a dedicated I/O thread so packing never waits on `write()`.
+/// When every buffer is queued, `write()` blocks (and `try_write()` fails)
+/// until the I/O thread frees one. With `direct` set, the file is opened
+/// with `O_DIRECT` where available. Writes must come from a single thread.
+class file_sink final {
+  /// @brief Alignment of every buffer (suitable for `O_DIRECT`)
+  static constexpr std::size_t alignment = 4096;
+
+  std::uint8_t** buffers_{};
+  std::size_t buffer_count_{};
+  std::size_t buffer_bytes_{};
+
+  /// @brief Index of the buffer being filled
+  std::size_t head_{};
+  /// @brief Index of the next buffer to write out
+  std::size_t tail_{};
+  /// @brief Number of buffers queued for the I/O thread
+  std::size_t pending_{};
+  /// @brief Bytes used in the buffer being filled
+  std::size_t fill_{};
+
+  int fd_{-1};
+  bool direct_{};
+  bool failed_{};
+  bool stopping_{};
+
+  std::mutex mutex_{};
+  std::condition_variable queued_{};
+  std::condition_variable released_{};
+  std::thread io_thread_{};
+
+  /// @brief Writes a whole range, retrying on short writes and `EINTR`
+  inline bool write_all(const std::uint8_t* bytes, std::size_t count) noexcept {
+    while (count != 0) {
+      auto n = ::write(this->fd_, bytes, count);
+
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+
+      bytes += n;
+      count -= (std::size_t)n;
+    }
+
+    return true;
+  }
+
+  /// @brief I/O thread body: writes queued buffers in order
+  inline void run() noexcept {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+
+    for (;;) {
+      this->queued_.wait(lock,
+                         [this] { return this->pending_ || this->stopping_; });
+
+      if (this->pending_ == 0) return;
+
+      auto buffer = this->buffers_[this->tail_];
+      auto drop = this->failed_;
+
+      // After a failed write the file is already short: drop the rest
+      lock.unlock();
+      auto ok = drop || this->write_all(buffer, this->buffer_bytes_);
+      lock.lock();
+
+      this->failed_ = this->failed_ || !ok;
+      this->tail_ = (this->tail_ + 1) % this->buffer_count_;
+      --this->pending_;
+      this->released_.notify_all();
+    }
+  }
+
+  /// @brief Queues the buffer being filled (caller holds the lock)
+  inline void submit() noexcept {
+    ++this->pending_;
+    this->head_ = (this->head_ + 1) % this->buffer_count_;
+    this->fill_ = 0;
+    this->queued_.notify_one();
+  }
+
+  /// @brief Copies bytes into buffers, optionally waiting for free ones
+  inline bool write_impl(const void* data, std::size_t count,
+                         bool wait) noexcept {
+    auto bytes = static_cast<const std::uint8_t*>(data);
+    std::unique_lock<std::mutex> lock(this->mutex_);
+
+    if (this->fd_ < 0 || this->failed_) return false;
+
+    if (!wait) {
+      auto free_bytes = (this->buffer_count_ - this->pending_) *
+                            this->buffer_bytes_ -
+                        this->fill_;
+      if (count > free_bytes) return false;
+    }
+
+    while (count != 0) {
+      this->released_.wait(lock, [this] {
+        return this->pending_ < this->buffer_count_ || this->failed_;
+      });
+
+      if (this->failed_) return false;
+
+      auto room = this->buffer_bytes_ - this->fill_;
+      auto n = count < room ? count : room;
+
+      // The filling buffer is never touched by the I/O thread
+      lock.unlock();
+      std::memcpy(this->buffers_[this->head_] + this->fill_, bytes, n);
+      lock.lock();
+
+      this->fill_ += n;
+      bytes += n;
+      count -= n;
+
+      if (this->fill_ == this->buffer_bytes_) this->submit();
+    }
+
+    return true;
+  }
+
+  /// @brief Releases buffers
+  inline void free_buffers() noexcept {
+    for (std::size_t i = 0; this->buffers_ && i < this->buffer_count_; ++i)
+      std::free(this->buffers_[i]);
+
+    delete[] this->buffers_;
+    this->buffers_ = nullptr;
+  }
+
+ public:
+  /// @brief Constructor (no allocation until `open()`)
+  /// @param buffer_bytes Size of each buffer (rounded up to 4096)
+  /// @param buffer_count Number of buffers (at least 2)
+  inline explicit file_sink(std::size_t buffer_bytes = 1 << 20,
+                            std::size_t buffer_count = 2) noexcept
+      : buffer_count_(buffer_count < 2 ? 2 : buffer_count),
+        buffer_bytes_((buffer_bytes + alignment - 1) / alignment *
+                      alignment) {
+    if (this->buffer_bytes_ == 0) this->buffer_bytes_ = alignment;
+  }
+
+  file_sink(const file_sink&) = delete;
+  file_sink& operator=(const file_sink&) = delete;
+
+  /// @brief Destructor (closes the file)
+  inline ~file_sink() { this->close(); }
+
+  /// @brief Creates (or truncates) a file and starts the I/O thread
+  /// @param path File path
+  /// @param direct Request `O_DIRECT` (ignored where unsupported)
+  /// @return `false` on failure (the sink stays closed)
+  inline bool open(const char* path, bool direct = false) noexcept {
+    if (this->fd_ >= 0) return false;
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    this->direct_ = false;
+
+#if defined(O_DIRECT)
+    if (direct) {
+      flags |= O_DIRECT;
+      this->direct_ = true;
+    }
+#else
+    (void)direct;
+#endif
+
+    this->buffers_ = new (std::nothrow) std::uint8_t*[this->buffer_count_]();
+    if (this->buffers_ == nullptr) return false;
+
+    for (std::size_t i = 0; i < this->buffer_count_; ++i) {
+      this->buffers_[i] = static_cast<std::uint8_t*>(
+          std::aligned_alloc(alignment, this->buffer_bytes_));
+
+      if (this->buffers_[i] == nullptr) {
+        this->free_buffers();
+        return false;
+      }
+    }
+
+    this->fd_ = ::open(path, flags, 0644);
+
+    if (this->fd_ < 0) {
+      this->free_buffers();
+      return false;
+    }
+
+    this->head_ = this->tail_ = this->pending_ = this->fill_ = 0;
+    this->failed_ = this->stopping_ = false;
+
+#if defined(__cpp_exceptions)
+    try {
+      this->io_thread_ = std::thread([this] { this->run(); });
+    } catch (...) {
+      ::close(this->fd_);
+      this->fd_ = -1;
+      this->free_buffers();
+      return false;
+    }
+#else
+    this->io_thread_ = std::thread([this] { this->run(); });
+#endif
+
+    return true;
+  }
+
+  /// @brief Copies bytes into the sink, blocking while all buffers are busy
+  /// @param data Pointer to first byte
+  /// @param count Number of bytes
+  /// @return `false` if the sink is closed or a write failed
+  inline bool write(const void* data, std::size_t count) noexcept {
+    return this->write_impl(data, count, true);
+  }
+
+  /// @brief Copies bytes into the sink only if it can do so without waiting
+  /// @param data Pointer to first byte
+  /// @param count Number of bytes
+  /// @return `false` if buffers are busy, the sink is closed or a write failed
+  inline bool try_write(const void* data, std::size_t count) noexcept {
+    return this->write_impl(data, count, false);
+  }
+
+  /// @brief Writes remaining data, stops the I/O thread and closes the file
+  /// @return `false` if any write failed
+  inline bool close() noexcept {
+    if (this->fd_ < 0) return !this->failed_;
+
+    {
+      std::unique_lock<std::mutex> lock(this->mutex_);
+      this->stopping_ = true;
+      this->queued_.notify_one();
+    }
+
+    this->io_thread_.join();
+
+    // The tail is rarely a multiple of the block size: finish unbuffered
+#if defined(O_DIRECT)
+    if (this->direct_ && this->fill_ != 0)
+      ::fcntl(this->fd_, F_SETFL, ::fcntl(this->fd_, F_GETFL) & ~O_DIRECT);
+#endif
+
+    if (this->fill_ != 0 && !this->failed_) {
+      auto tail = this->buffers_[this->head_];
+      this->failed_ = !this->write_all(tail, this->fill_);
+    }
+
+    this->failed_ = (::close(this->fd_) != 0) || this->failed_;
+    this->fd_ = -1;
+    this->fill_ = 0;
+    this->free_buffers();
+    return !this->failed_;
+  }
+
+  /// @brief Checks if a file is open
+  /// @return `true` between a successful `open()` and `close()`
+  inline bool is_open() const noexcept { return this->fd_ >= 0; }
+
+  /// @brief Checks if `O_DIRECT` is in effect
+  /// @return `true` if the file was opened with `O_DIRECT`
+  inline bool direct() const noexcept { return this->direct_; }
+
+  /// @brief Returns the size of each buffer
+  /// @return Byte count
+  inline std::size_t buffer_bytes() const noexcept {
+    return this->buffer_bytes_;
+  }
+
+  /// @brief Returns the number of buffers
+  /// @return Buffer count
+  inline std::size_t buffer_count() const noexcept {
+    return this->buffer_count_;
+  }
+};
+
+/// @brief `packed_writer` sink that forwards chunks to a `file_sink`
+/// @tparam W Bit width of packed values
+///
+/// Chunks are written back to back as raw words. The first failed write is
+/// latched: check `writer.sink().ok()` before trusting the file.
+template <std::size_t W>
+class file_chunk_sink final {
+  file_sink* file_;
+  bool failed_{};
+
+ public:
+  /// @brief Constructor
+  /// @param file Destination
+  inline explicit file_chunk_sink(file_sink& file) noexcept : file_(&file) {}
+
+  /// @brief Writes the words of one chunk
+  /// @param words Pointer to first word
+  /// @param item_count Number of values in the chunk
+  inline void operator()(const std::uintmax_t* words,
+                         std::size_t item_count) noexcept {
+    auto word_count = impl::width_dispatcher::words_for(item_count, W);
+
+    if (!this->file_->write(words, word_count * sizeof(std::uintmax_t)))
+      this->failed_ = true;
+  }
+
+  /// @brief Checks if every chunk was accepted by the file
+  /// @return `false` once any write has failed
+  inline bool ok() const noexcept { return !this->failed_; }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_FILE_H_
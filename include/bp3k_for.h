@@ -0,0 +1,275 @@
+#ifndef _BITPACKER3000_FOR_H_
+#define _BITPACKER3000_FOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "bp3k.h"
+
+namespace bp3k {
+
+/// @brief Frame-of-reference array: per-block base value plus W-bit offsets
+/// @tparam T I/O value type (signed/unsigned integral type)
+/// @tparam W Bit width of packed offsets
+/// @tparam N Packed-value capacity
+/// @tparam B Number of values sharing one base
+template <typename T, std::size_t W, std::size_t N, std::size_t B = 128>
+class for_packer final {
+  static_assert(std::is_integral<T>::value, "T must be an integral type");
+  static_assert(B != 0, "B must be non-zero");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  using offset_type = impl::fit_unsigned<W>;
+  using offset_packer = bitpacker<offset_type, W, N>;
+  using lane = impl::lane_dispatcher<offset_type, W>;
+
+  static constexpr std::size_t block_count_ = (N + B - 1) / B;
+
+  T bases_[block_count_]{};
+  offset_packer offsets_{};
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of values sharing one base
+  static constexpr std::size_t block_size = B;
+
+  /// @brief Number of blocks (and bases)
+  static constexpr std::size_t block_count = block_count_;
+
+  /// @brief Largest difference from a block's base that can be stored
+  static constexpr offset_type offset_max = offset_packer::value_max;
+
+  /// @brief Default constructor (all values zero)
+  for_packer() = default;
+
+  /// @brief Encodes `N` values, choosing each block's minimum as its base
+  /// @param values Pointer to `N` input values
+  /// @return `false` if a block spans more than `offset_max` (nothing is
+  /// modified in that case)
+  inline constexpr bool encode(const T* values) noexcept {
+    T bases[block_count_]{};
+
+    for (std::size_t b = 0; b < block_count_; ++b) {
+      auto first = b * B;
+      auto last = first + B < N ? first + B : N;
+      T lo = values[first], hi = values[first];
+
+      for (std::size_t i = first + 1; i < last; ++i) {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+      }
+
+      if ((unsigned_type)((unsigned_type)hi - (unsigned_type)lo) >
+          (unsigned_type)offset_max)
+        return false;
+
+      bases[b] = lo;
+    }
+
+    for (std::size_t b = 0; b < block_count_; ++b) this->bases_[b] = bases[b];
+
+    for (std::size_t i = 0; i < N; ++i)
+      this->offsets_[i] = (offset_type)((unsigned_type)values[i] -
+                                        (unsigned_type)bases[i / B]);
+
+    return true;
+  }
+
+  /// @brief Decodes all values
+  /// @param out Pointer to `N` output values
+  inline constexpr void decode(T* out) const noexcept {
+    const std::uintmax_t* words = this->offsets_.data();
+    std::size_t pos = 0;
+
+    for (std::size_t i = 0; pos < N; ++i) {
+      auto offset = lane::front_offset;
+      auto end = pos + lane::per_word < N ? pos + lane::per_word : N;
+
+      for (; pos < end; ++pos, offset -= W) {
+        auto delta = lane::extract_value(&words[i], offset);
+        out[pos] = (T)((unsigned_type)this->bases_[pos / B] + delta);
+      }
+    }
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T at(std::size_t pos) const noexcept {
+    return (T)((unsigned_type)this->bases_[pos / B] +
+               (unsigned_type)(offset_type)this->offsets_[pos]);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T operator[](std::size_t pos) const noexcept {
+    return this->at(pos);
+  }
+
+  /// @brief Stores a value if it fits its block's frame
+  /// @param pos Index of item
+  /// @param x Value to store
+  /// @return `false` if `x` is outside `[base, base + offset_max]`
+  inline constexpr bool set(std::size_t pos, T x) noexcept {
+    T base = this->bases_[pos / B];
+    auto delta = (unsigned_type)((unsigned_type)x - (unsigned_type)base);
+
+    if (x < base || delta > (unsigned_type)offset_max) return false;
+
+    this->offsets_[pos] = (offset_type)delta;
+    return true;
+  }
+
+  /// @brief Fetches the base value of a block
+  /// @param block Index of block
+  /// @return Block base
+  inline constexpr T base(std::size_t block) const noexcept {
+    return this->bases_[block];
+  }
+
+  /// @brief Fetches the underlying offset packer
+  /// @return Const reference to offsets
+  inline constexpr const offset_packer& offsets() const noexcept {
+    return this->offsets_;
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return N
+  inline constexpr std::size_t size() const noexcept { return N; }
+};
+
+/// @brief Delta-encoded array: W-bit differences with periodic checkpoints
+/// @tparam T I/O value type (signed/unsigned integral type)
+/// @tparam W Bit width of packed (two's complement) differences
+/// @tparam N Packed-value capacity
+/// @tparam C Checkpoint interval (one absolute value per C values)
+///
+/// Random access costs at most `C - 1` delta extractions.
+template <typename T, std::size_t W, std::size_t N, std::size_t C = 128>
+class delta_packer final {
+  static_assert(std::is_integral<T>::value, "T must be an integral type");
+  static_assert(C != 0, "C must be non-zero");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  using signed_type = typename std::make_signed<T>::type;
+  using delta_type = impl::fit_signed<W>;
+  using delta_packer_type = bitpacker<delta_type, W, N>;
+  using lane = impl::lane_dispatcher<delta_type, W>;
+
+  static constexpr std::size_t checkpoint_count_ = (N + C - 1) / C;
+
+  T checkpoints_[checkpoint_count_]{};
+  delta_packer_type deltas_{};
+
+  /// @brief Converts a stored difference to the wrapping domain of T
+  static inline constexpr unsigned_type widen(
+      typename lane::unsigned_type w_bits) noexcept {
+    return (unsigned_type)(signed_type)(delta_type)w_bits;
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Checkpoint interval
+  static constexpr std::size_t checkpoint_interval = C;
+
+  /// @brief Smallest storable difference
+  static constexpr delta_type delta_min = delta_packer_type::value_min;
+
+  /// @brief Largest storable difference
+  static constexpr delta_type delta_max = delta_packer_type::value_max;
+
+  /// @brief Default constructor (all values zero)
+  delta_packer() = default;
+
+  /// @brief Encodes `N` values as checkpoints plus successive differences
+  /// @param values Pointer to `N` input values
+  /// @return `false` if a difference is outside `[delta_min, delta_max]`
+  /// (nothing is modified in that case)
+  inline constexpr bool encode(const T* values) noexcept {
+    for (std::size_t i = 1; i < N; ++i) {
+      if (i % C == 0) continue;
+
+      auto d = (signed_type)(unsigned_type)((unsigned_type)values[i] -
+                                            (unsigned_type)values[i - 1]);
+
+      if (d < (signed_type)delta_min || d > (signed_type)delta_max)
+        return false;
+    }
+
+    for (std::size_t i = 0; i < N; ++i) {
+      if (i % C == 0) {
+        this->checkpoints_[i / C] = values[i];
+        this->deltas_[i] = (delta_type)0;
+      } else {
+        this->deltas_[i] = (delta_type)((unsigned_type)values[i] -
+                                        (unsigned_type)values[i - 1]);
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief Decodes all values (running prefix sum)
+  /// @param out Pointer to `N` output values
+  inline constexpr void decode(T* out) const noexcept {
+    const std::uintmax_t* words = this->deltas_.data();
+    unsigned_type acc{};
+    std::size_t pos = 0;
+
+    for (std::size_t i = 0; pos < N; ++i) {
+      auto offset = lane::front_offset;
+      auto end = pos + lane::per_word < N ? pos + lane::per_word : N;
+
+      for (; pos < end; ++pos, offset -= W) {
+        if (pos % C == 0)
+          acc = (unsigned_type)this->checkpoints_[pos / C];
+        else
+          acc += widen(lane::extract_value(&words[i], offset));
+
+        out[pos] = (T)acc;
+      }
+    }
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T at(std::size_t pos) const noexcept {
+    const std::uintmax_t* words = this->deltas_.data();
+    auto first = pos - pos % C;
+    auto acc = (unsigned_type)this->checkpoints_[pos / C];
+
+    for (std::size_t i = first + 1; i <= pos; ++i)
+      acc += widen(lane::extract_value(&words[lane::word_index(i)],
+                                       lane::item_offset(i)));
+
+    return (T)acc;
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline constexpr T operator[](std::size_t pos) const noexcept {
+    return this->at(pos);
+  }
+
+  /// @brief Fetches the underlying difference packer
+  /// @return Const reference to differences
+  inline constexpr const delta_packer_type& deltas() const noexcept {
+    return this->deltas_;
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return N
+  inline constexpr std::size_t size() const noexcept { return N; }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_FOR_H_
@@ -0,0 +1,262 @@
+#ifndef _BITPACKER3000_GENERATOR_H_
+#define _BITPACKER3000_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define BP3K_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef BP3K_HAS_COROUTINES
+#define BP3K_HAS_COROUTINES 0
+#endif
+
+#if BP3K_HAS_COROUTINES
+
+#include <coroutine>
+
+namespace bp3k {
+
+/// @brief Contiguous run of decoded values (valid until the producer resumes)
+/// @tparam T Value type
+template <typename T>
+struct value_block final {
+  /// @brief Pointer to first value
+  const T* values;
+  /// @brief Number of values
+  std::size_t count;
+
+  inline const T* begin() const noexcept { return this->values; }
+  inline const T* end() const noexcept { return this->values + this->count; }
+  inline std::size_t size() const noexcept { return this->count; }
+  inline bool empty() const noexcept { return this->count == 0; }
+
+  inline const T& operator[](std::size_t i) const noexcept {
+    return this->values[i];
+  }
+};
+
+/// @brief Number of values per block produced by `decode_blocks()`
+constexpr std::size_t default_block_items = 512;
+
+/// @brief Lazy producer of decoded blocks (C++20 coroutine)
+/// @tparam T Value type
+///
+/// Blocks point into the coroutine frame, so each one is only valid until
+/// the next call to `next()`. Frames are allocated without throwing; if
+/// allocation fails the generator is simply empty (`valid()` is `false`).
+template <typename T>
+class block_generator final {
+ public:
+  /// @brief Coroutine promise
+  struct promise_type final {
+    value_block<T> current{nullptr, 0};
+
+    static inline void* operator new(std::size_t size) noexcept {
+      return ::operator new(size, std::nothrow);
+    }
+
+    static inline void operator delete(void* frame) noexcept {
+      ::operator delete(frame);
+    }
+
+    static inline block_generator get_return_object_on_allocation_failure()
+        noexcept {
+      return block_generator();
+    }
+
+    inline block_generator get_return_object() noexcept {
+      return block_generator(handle::from_promise(*this));
+    }
+
+    inline std::suspend_always initial_suspend() noexcept { return {}; }
+    inline std::suspend_always final_suspend() noexcept { return {}; }
+
+    inline std::suspend_always yield_value(value_block<T> block) noexcept {
+      this->current = block;
+      return {};
+    }
+
+    inline void return_void() noexcept {}
+    inline void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+ private:
+  using handle = std::coroutine_handle<promise_type>;
+
+  handle handle_{};
+
+  inline explicit block_generator(handle h) noexcept : handle_(h) {}
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Default constructor (empty generator)
+  block_generator() = default;
+
+  block_generator(const block_generator&) = delete;
+  block_generator& operator=(const block_generator&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Generator to take ownership from
+  inline block_generator(block_generator&& other) noexcept
+      : handle_(std::exchange(other.handle_, {})) {}
+
+  /// @brief Move assignment
+  /// @param other Generator to take ownership from
+  /// @return Self reference
+  inline block_generator& operator=(block_generator&& other) noexcept {
+    if (this != &other) {
+      if (this->handle_) this->handle_.destroy();
+      this->handle_ = std::exchange(other.handle_, {});
+    }
+
+    return *this;
+  }
+
+  /// @brief Destructor (destroys the coroutine frame)
+  inline ~block_generator() {
+    if (this->handle_) this->handle_.destroy();
+  }
+
+  /// @brief Checks if a coroutine frame is attached
+  /// @return `false` for a default-constructed or failed generator
+  inline bool valid() const noexcept { return (bool)this->handle_; }
+
+  /// @brief Produces the next non-empty block
+  /// @return `false` once the producer is exhausted
+  inline bool next() noexcept {
+    while (this->handle_ && !this->handle_.done()) {
+      this->handle_.resume();
+
+      if (this->handle_.done()) break;
+      if (this->handle_.promise().current.count != 0) return true;
+    }
+
+    return false;
+  }
+
+  /// @brief Fetches the block produced by the last successful `next()`
+  /// @return Block
+  inline value_block<T> block() const noexcept {
+    return this->handle_.promise().current;
+  }
+};
+
+/// @brief Decodes a container lazily, one block at a time
+/// @tparam B Values per block (the buffer lives in the coroutine frame)
+/// @tparam Container Type with `value_type`, `size()` and either
+/// `unpack(pos, count, out)` or `at(pos)`
+/// @param source Container (must outlive the generator)
+/// @return Generator of decoded blocks
+template <std::size_t B = default_block_items, typename Container>
+inline block_generator<typename Container::value_type> decode_blocks(
+    const Container& source) {
+  using value_type = typename Container::value_type;
+
+  static_assert(B != 0, "B must be non-zero");
+
+  value_type buffer[B];
+  const std::size_t size = source.size();
+
+  for (std::size_t pos = 0; pos < size; pos += B) {
+    auto count = size - pos < B ? size - pos : B;
+
+    if constexpr (requires { source.unpack(pos, count, buffer); }) {
+      source.unpack(pos, count, buffer);
+    } else {
+      for (std::size_t i = 0; i < count; ++i) buffer[i] = source.at(pos + i);
+    }
+
+    co_yield value_block<value_type>{buffer, count};
+  }
+}
+
+/// @brief Keeps the values of each block that satisfy a predicate
+/// @tparam B Capacity of the output buffer (at least the input block size)
+/// @param source Upstream generator
+/// @param pred Callable as `pred(T) -> bool`
+/// @return Generator of filtered blocks (empty blocks are skipped)
+template <std::size_t B = default_block_items, typename T, typename Pred>
+inline block_generator<T> filter_blocks(block_generator<T> source,
+                                        Pred pred) {
+  T buffer[B];
+
+  while (source.next()) {
+    auto block = source.block();
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < block.count; ++i) {
+      if (pred(block.values[i])) {
+        buffer[count++] = block.values[i];
+
+        if (count == B) {
+          co_yield value_block<T>{buffer, count};
+          count = 0;
+        }
+      }
+    }
+
+    if (count != 0) co_yield value_block<T>{buffer, count};
+  }
+}
+
+/// @brief Maps every value of each block
+/// @tparam B Capacity of the output buffer (at least the input block size)
+/// @param source Upstream generator
+/// @param f Callable as `f(T) -> U`
+/// @return Generator of transformed blocks
+template <std::size_t B = default_block_items, typename T, typename F,
+          typename U = std::invoke_result_t<F&, T>>
+inline block_generator<U> transform_blocks(block_generator<T> source, F f) {
+  U buffer[B];
+
+  while (source.next()) {
+    auto block = source.block();
+
+    for (std::size_t pos = 0; pos < block.count; pos += B) {
+      auto count = block.count - pos < B ? block.count - pos : B;
+
+      for (std::size_t i = 0; i < count; ++i)
+        buffer[i] = f(block.values[pos + i]);
+
+      co_yield value_block<U>{buffer, count};
+    }
+  }
+}
+
+/// @brief Pushes every block into a streaming encoder
+/// @tparam Writer Type with `push(const T*, std::size_t)` (e.g.
+/// `packed_writer`)
+/// @param source Upstream generator
+/// @param writer Destination
+/// @return Number of values pushed
+template <typename T, typename Writer>
+inline std::size_t feed(block_generator<T>& source, Writer& writer) {
+  std::size_t total = 0;
+
+  while (source.next()) {
+    auto block = source.block();
+
+    writer.push(block.values, block.count);
+    total += block.count;
+  }
+
+  return total;
+}
+
+}  // namespace bp3k
+
+#endif  // BP3K_HAS_COROUTINES
+
+#endif  // !_BITPACKER3000_GENERATOR_H_
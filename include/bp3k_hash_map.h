@@ -0,0 +1,359 @@
+#ifndef _BITPACKER3000_HASH_MAP_H_
+#define _BITPACKER3000_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Open-addressing hash map with bit-packed keys and values
+/// @tparam KeyW Bit width of keys
+/// @tparam ValueW Bit width of values
+///
+/// Robin Hood linear probing over a power-of-two slot count, kept at most
+/// 15/16 full. Each slot is split across two packed arrays: a `dist_bits +
+/// KeyW` lane holding the probe distance plus one (0 marks an empty slot)
+/// and the key, and a `ValueW` lane holding the value. Lookups stop as soon
+/// as a slot is closer to its home than the probe, so they touch one or two
+/// cache lines of each array. Erasure shifts the following run back, so no
+/// tombstones are needed.
+template <std::size_t KeyW, std::size_t ValueW>
+class packed_hash_map final {
+ public:
+  /// @brief Key type
+  using key_type = impl::fit_unsigned<KeyW>;
+
+  /// @brief Value type
+  using mapped_type = impl::fit_unsigned<ValueW>;
+
+  /// @brief Bits storing a slot's probe distance
+  static constexpr std::size_t dist_bits = 6;
+
+  /// @brief Longest probe distance before the table grows
+  static constexpr std::size_t max_distance = (1u << dist_bits) - 2;
+
+ private:
+  static constexpr std::size_t slot_w = dist_bits + KeyW;
+
+  static_assert(KeyW != 0 && slot_w <= 64, "KeyW must be in [1, 58]");
+  static_assert(ValueW != 0 && ValueW <= 64, "ValueW must be in [1, 64]");
+
+  using slot_type = impl::fit_unsigned<slot_w>;
+  using slot_lane = impl::lane_dispatcher<slot_type, slot_w>;
+  using value_lane = impl::lane_dispatcher<mapped_type, ValueW>;
+
+  static constexpr std::uintmax_t key_mask =
+      ~(std::uintmax_t)0 >> (sizeof(std::uintmax_t) * 8 - KeyW);
+  static constexpr std::size_t min_capacity = 16;
+
+  impl::word_buffer slots_{};
+  impl::word_buffer values_{};
+  std::size_t capacity_{};
+  std::size_t size_{};
+
+  /// @brief Reads a slot (0 if empty)
+  static inline std::uintmax_t slot_at(const impl::word_buffer& slots,
+                                       std::size_t pos) noexcept {
+    return slot_lane::extract_value(&slots.data()[slot_lane::word_index(pos)],
+                                    slot_lane::item_offset(pos));
+  }
+
+  /// @brief Writes a slot
+  static inline void set_slot(impl::word_buffer& slots, std::size_t pos,
+                              std::uintmax_t slot) noexcept {
+    slot_lane::embed_value(&slots.data()[slot_lane::word_index(pos)],
+                           slot_lane::item_offset(pos), (slot_type)slot);
+  }
+
+  /// @brief Reads a value
+  static inline mapped_type value_at(const impl::word_buffer& values,
+                                     std::size_t pos) noexcept {
+    return value_lane::extract_value(
+        &values.data()[value_lane::word_index(pos)],
+        value_lane::item_offset(pos));
+  }
+
+  /// @brief Writes a value
+  static inline void set_value(impl::word_buffer& values, std::size_t pos,
+                               mapped_type value) noexcept {
+    value_lane::embed_value(&values.data()[value_lane::word_index(pos)],
+                            value_lane::item_offset(pos), value);
+  }
+
+  /// @brief Builds a slot from a probe distance and a key
+  static inline constexpr std::uintmax_t make_slot(
+      std::size_t dist, std::uintmax_t key) noexcept {
+    return ((std::uintmax_t)(dist + 1) << KeyW) | key;
+  }
+
+  /// @brief Extracts the probe distance of an occupied slot
+  static inline constexpr std::size_t distance_of(
+      std::uintmax_t slot) noexcept {
+    return (std::size_t)(slot >> KeyW) - 1;
+  }
+
+  /// @brief Computes the home slot of a key
+  static inline constexpr std::size_t home_of(std::uintmax_t key,
+                                              std::size_t capacity) noexcept {
+    return (std::size_t)impl::mix64(key) & (capacity - 1);
+  }
+
+  /// @brief Finds the slot holding a key
+  /// @return Slot index, or `capacity_` if absent
+  inline std::size_t locate(std::uintmax_t key) const noexcept {
+    if (this->capacity_ == 0) return 0;
+
+    auto mask = this->capacity_ - 1;
+    auto pos = home_of(key, this->capacity_);
+
+    for (std::size_t dist = 0;; ++dist, pos = (pos + 1) & mask) {
+      auto slot = slot_at(this->slots_, pos);
+
+      // Robin Hood invariant: the key would have displaced this slot
+      if (slot == 0 || distance_of(slot) < dist) return this->capacity_;
+      if ((slot & key_mask) == key) return pos;
+    }
+  }
+
+  /// @brief Inserts a key known to be absent (all-or-nothing)
+  /// @return `false` if some probe distance would exceed `max_distance`
+  static inline bool place(impl::word_buffer& slots,
+                           impl::word_buffer& values, std::size_t capacity,
+                           std::uintmax_t key, mapped_type value) noexcept {
+    auto mask = capacity - 1;
+    auto pos = home_of(key, capacity);
+    std::size_t dist = 0;
+
+    // Robin Hood: take the first slot that is closer to its home
+    for (;; ++dist, pos = (pos + 1) & mask) {
+      if (dist > max_distance) return false;
+
+      auto slot = slot_at(slots, pos);
+      if (slot == 0 || distance_of(slot) < dist) break;
+    }
+
+    // Everything up to the next empty slot shifts one place further
+    auto end = pos;
+
+    for (; slot_at(slots, end) != 0; end = (end + 1) & mask) {
+      if (distance_of(slot_at(slots, end)) == max_distance) return false;
+    }
+
+    for (auto i = end; i != pos;) {
+      auto prev = (i - 1) & mask;
+      auto slot = slot_at(slots, prev);
+
+      set_slot(slots, i, make_slot(distance_of(slot) + 1, slot & key_mask));
+      set_value(values, i, value_at(values, prev));
+      i = prev;
+    }
+
+    set_slot(slots, pos, make_slot(dist, key));
+    set_value(values, pos, value);
+    return true;
+  }
+
+  /// @brief Rehashes into a table of at least `capacity` slots
+  /// @return `false` if allocation failed (the map is untouched)
+  inline bool rehash(std::size_t capacity) noexcept {
+    for (;; capacity <<= 1) {
+      impl::word_buffer slots(this->resource()), values(this->resource());
+
+      if (!slots.allocate(slot_lane::words_for(capacity)) ||
+          !values.allocate(value_lane::words_for(capacity)))
+        return false;
+
+      bool placed = true;
+
+      for (std::size_t i = 0; placed && i < this->capacity_; ++i) {
+        auto slot = slot_at(this->slots_, i);
+
+        if (slot != 0)
+          placed = place(slots, values, capacity, slot & key_mask,
+                         value_at(this->values_, i));
+      }
+
+      if (!placed) continue;
+
+      this->slots_.swap(slots);
+      this->values_.swap(values);
+      this->capacity_ = capacity;
+      return true;
+    }
+  }
+
+ public:
+  /// @brief Default constructor (no allocation)
+  packed_hash_map() = default;
+
+  /// @brief Constructor (no allocation)
+  /// @param resource Source of slot storage (null for the global heap)
+  inline explicit packed_hash_map(
+      std::pmr::memory_resource* resource) noexcept
+      : slots_(resource), values_(resource) {}
+
+  packed_hash_map(const packed_hash_map&) = delete;
+  packed_hash_map& operator=(const packed_hash_map&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Map to take ownership from
+  inline packed_hash_map(packed_hash_map&& other) noexcept {
+    this->swap(other);
+  }
+
+  /// @brief Move assignment
+  /// @param other Map to take ownership from
+  /// @return Self reference
+  inline packed_hash_map& operator=(packed_hash_map&& other) noexcept {
+    packed_hash_map tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents of the map with those of `other`
+  /// @param other Map to swap with
+  inline void swap(packed_hash_map& other) noexcept {
+    this->slots_.swap(other.slots_);
+    this->values_.swap(other.values_);
+    std::swap(this->capacity_, other.capacity_);
+    std::swap(this->size_, other.size_);
+  }
+
+  /// @brief Makes room for `count` entries without further rehashing
+  /// @param count Number of entries
+  /// @return `false` if allocation failed (the map is untouched)
+  inline bool reserve(std::size_t count) noexcept {
+    auto capacity = this->capacity_ ? this->capacity_ : min_capacity;
+
+    while (count * 16 > capacity * 15) capacity <<= 1;
+
+    return capacity == this->capacity_ || this->rehash(capacity);
+  }
+
+  /// @brief Inserts a key or replaces its value
+  /// @param key Key (truncated to KeyW bits)
+  /// @param value Value (truncated to ValueW bits)
+  /// @return `false` if allocation failed (the map is untouched)
+  inline bool insert_or_assign(key_type key, mapped_type value) noexcept {
+    auto k = (std::uintmax_t)key & key_mask;
+    auto pos = this->locate(k);
+
+    if (pos != this->capacity_) {
+      set_value(this->values_, pos, value);
+      return true;
+    }
+
+    if (!this->reserve(this->size_ + 1)) return false;
+
+    while (!place(this->slots_, this->values_, this->capacity_, k, value)) {
+      if (!this->rehash(this->capacity_ << 1)) return false;
+    }
+
+    ++this->size_;
+    return true;
+  }
+
+  /// @brief Looks up a key
+  /// @param key Key
+  /// @param value Output value (unchanged if the key is absent)
+  /// @return `true` if the key is present
+  inline bool find(key_type key, mapped_type& value) const noexcept {
+    auto pos = this->locate((std::uintmax_t)key & key_mask);
+
+    if (pos == this->capacity_) return false;
+
+    value = value_at(this->values_, pos);
+    return true;
+  }
+
+  /// @brief Checks if a key is present
+  /// @param key Key
+  /// @return `true` if the key is present
+  inline bool contains(key_type key) const noexcept {
+    return this->locate((std::uintmax_t)key & key_mask) != this->capacity_;
+  }
+
+  /// @brief Removes a key
+  /// @param key Key
+  /// @return `true` if the key was present
+  inline bool erase(key_type key) noexcept {
+    auto pos = this->locate((std::uintmax_t)key & key_mask);
+
+    if (pos == this->capacity_) return false;
+
+    auto mask = this->capacity_ - 1;
+
+    // Backward shift: pull the rest of the run one slot closer to home
+    for (auto next = (pos + 1) & mask;; next = (next + 1) & mask) {
+      auto slot = slot_at(this->slots_, next);
+
+      if (slot == 0 || distance_of(slot) == 0) break;
+
+      set_slot(this->slots_, pos,
+               make_slot(distance_of(slot) - 1, slot & key_mask));
+      set_value(this->values_, pos, value_at(this->values_, next));
+      pos = next;
+    }
+
+    set_slot(this->slots_, pos, 0);
+    --this->size_;
+    return true;
+  }
+
+  /// @brief Removes all entries (keeps the capacity)
+  inline void clear() noexcept {
+    auto words = this->slots_.data();
+
+    for (std::size_t i = 0; i < slot_lane::words_for(this->capacity_); ++i)
+      words[i] = 0;
+
+    this->size_ = 0;
+  }
+
+  /// @brief Visits every entry (in slot order)
+  /// @tparam F Callable as `f(key_type, mapped_type)`
+  /// @param f Visitor
+  template <typename F>
+  inline void for_each(F&& f) const {
+    for (std::size_t i = 0; i < this->capacity_; ++i) {
+      auto slot = slot_at(this->slots_, i);
+
+      if (slot != 0) f((key_type)(slot & key_mask), value_at(this->values_, i));
+    }
+  }
+
+  /// @brief Returns the number of entries
+  /// @return Entry count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Checks if the map has no entries
+  /// @return `true` if the map is empty
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of slots
+  /// @return Slot count
+  inline std::size_t capacity() const noexcept { return this->capacity_; }
+
+  /// @brief Returns the heap footprint of both packed arrays
+  /// @return Byte count
+  inline std::size_t bytes_used() const noexcept {
+    return (slot_lane::words_for(this->capacity_) +
+            value_lane::words_for(this->capacity_)) *
+           sizeof(std::uintmax_t);
+  }
+
+  /// @brief Returns the source of slot storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->slots_.resource();
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_HASH_MAP_H_
@@ -0,0 +1,427 @@
+#ifndef _BITPACKER3000_PARALLEL_H_
+#define _BITPACKER3000_PARALLEL_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+
+namespace bp3k {
+
+/// @brief Executor that runs every task on the calling thread
+struct sequential_executor final {
+  /// @brief Runs `task(i)` for every `i` in `[0, task_count)`
+  /// @tparam F Callable as `task(std::size_t)`
+  /// @param task_count Number of tasks
+  /// @param task Task body
+  template <typename F>
+  inline void operator()(std::size_t task_count, F&& task) const {
+    for (std::size_t i = 0; i < task_count; ++i) task(i);
+  }
+};
+
+/// @brief Fixed-size thread pool usable as an executor
+///
+/// Idle threads claim the next unclaimed task from a shared counter, so fast
+/// threads take over the work of slow ones; the submitting thread joins in
+/// and returns once every task has run. Tasks must not throw, and must not
+/// submit to the same pool: the nested call would wait on the submit lock
+/// held by the outer one and deadlock.
+class thread_pool final {
+  std::thread* workers_{};
+  std::size_t worker_count_{};
+
+  std::mutex submit_mutex_{};
+  std::mutex mutex_{};
+  std::condition_variable wake_{};
+  std::condition_variable done_{};
+  std::size_t generation_{};
+  std::size_t finished_{};
+  bool stopping_{};
+
+  void (*invoke_)(void*, std::size_t){};
+  void* context_{};
+  std::size_t task_count_{};
+  std::atomic<std::size_t> next_{};
+
+  /// @brief Claims and runs tasks until none are left
+  inline void run_tasks() noexcept {
+    for (;;) {
+      auto i = this->next_.fetch_add(1, std::memory_order_relaxed);
+      if (i >= this->task_count_) return;
+
+      this->invoke_(this->context_, i);
+    }
+  }
+
+  /// @brief Worker thread body
+  inline void run() noexcept {
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+
+    for (;;) {
+      this->wake_.wait(lock, [&] {
+        return this->stopping_ || this->generation_ != seen;
+      });
+
+      if (this->stopping_) return;
+
+      seen = this->generation_;
+      lock.unlock();
+      this->run_tasks();
+      lock.lock();
+
+      if (++this->finished_ == this->worker_count_) this->done_.notify_one();
+    }
+  }
+
+ public:
+  /// @brief Default worker count: one per core minus the submitting thread
+  /// @return `hardware_concurrency() - 1` (0 if unknown or single-core)
+  static inline std::size_t default_workers() noexcept {
+    auto cores = (std::size_t)std::thread::hardware_concurrency();
+    return cores != 0 ? cores - 1 : 0;
+  }
+
+  /// @brief Constructor
+  /// @param threads Number of worker threads (besides the submitting thread)
+  inline explicit thread_pool(
+      std::size_t threads = default_workers()) noexcept {
+    if (threads == 0) return;
+
+    this->workers_ = new (std::nothrow) std::thread[threads];
+    if (this->workers_ == nullptr) return;
+
+    // Run with however many threads could be started
+    for (; this->worker_count_ < threads; ++this->worker_count_) {
+#if defined(__cpp_exceptions)
+      try {
+        this->workers_[this->worker_count_] =
+            std::thread([this] { this->run(); });
+      } catch (...) {
+        break;
+      }
+#else
+      this->workers_[this->worker_count_] =
+          std::thread([this] { this->run(); });
+#endif
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /// @brief Destructor (joins all workers)
+  inline ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->stopping_ = true;
+    }
+
+    this->wake_.notify_all();
+
+    for (std::size_t i = 0; i < this->worker_count_; ++i)
+      this->workers_[i].join();
+
+    delete[] this->workers_;
+  }
+
+  /// @brief Returns the number of worker threads
+  /// @return Worker count
+  inline std::size_t size() const noexcept { return this->worker_count_; }
+
+  /// @brief Runs `task(i)` for every `i` in `[0, task_count)` and waits
+  /// @tparam F Callable as `task(std::size_t)`
+  /// @param task_count Number of tasks
+  /// @param task Task body
+  template <typename F>
+  inline void operator()(std::size_t task_count, F&& task) {
+    using task_type = typename std::remove_reference<F>::type;
+
+    if (this->worker_count_ == 0 || task_count < 2) {
+      for (std::size_t i = 0; i < task_count; ++i) task(i);
+      return;
+    }
+
+    std::lock_guard<std::mutex> submit(this->submit_mutex_);
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->invoke_ = [](void* context, std::size_t i) {
+        (*static_cast<task_type*>(context))(i);
+      };
+      this->context_ = const_cast<void*>(
+          static_cast<const volatile void*>(std::addressof(task)));
+      this->task_count_ = task_count;
+      this->next_.store(0, std::memory_order_relaxed);
+      this->finished_ = 0;
+      ++this->generation_;
+    }
+
+    this->wake_.notify_all();
+    this->run_tasks();
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->done_.wait(lock, [this] {
+      return this->finished_ == this->worker_count_;
+    });
+  }
+};
+
+}  // namespace bp3k
+
+namespace bp3k::impl {
+
+/// @brief Splits `[0, item_count)` into aligned ranges and runs them
+/// @tparam Executor Callable as `exec(std::size_t task_count, task)`
+/// @tparam F Callable as `f(std::size_t task, std::size_t first,
+/// std::size_t last)`
+/// @param item_count Number of items
+/// @param align Range boundaries are multiples of this (whole words)
+/// @param grain Preferred number of items per range
+/// @param max_tasks Upper bound on the number of ranges
+/// @param exec Executor
+/// @param f Range body
+/// @return Number of ranges
+template <typename Executor, typename F>
+inline std::size_t split_items(std::size_t item_count, std::size_t align,
+                               std::size_t grain, std::size_t max_tasks,
+                               Executor&& exec, F&& f) {
+  if (item_count == 0) return 0;
+
+  if (grain < align) grain = align;
+  if ((item_count + grain - 1) / grain > max_tasks)
+    grain = (item_count + max_tasks - 1) / max_tasks;
+
+  grain = (grain + align - 1) / align * align;
+
+  auto task_count = (item_count + grain - 1) / grain;
+
+  exec(task_count, [&](std::size_t task) {
+    auto first = task * grain;
+    auto last = first + grain < item_count ? first + grain : item_count;
+    f(task, first, last);
+  });
+
+  return task_count;
+}
+
+/// @brief Builds an array whose elements are all copies of `value`
+template <typename U, std::size_t... Is>
+inline std::array<U, sizeof...(Is)> filled_array(
+    const U& value, std::index_sequence<Is...>) {
+  return {{((void)Is, value)...}};
+}
+
+/// @brief Computes the greatest common divisor of two constants
+template <std::size_t A, std::size_t B>
+inline constexpr std::size_t gcd() noexcept {
+  if constexpr (B == 0)
+    return A;
+  else
+    return gcd<B, A % B>();
+}
+
+}  // namespace bp3k::impl
+
+/// @brief Bulk operations that split work across threads on word boundaries
+namespace bp3k::parallel {
+
+/// @brief Default number of items per task
+constexpr std::size_t default_grain = std::size_t{1} << 16;
+
+/// @brief Upper bound on the number of tasks of one operation
+constexpr std::size_t max_tasks = 1024;
+
+/// @brief Upper bound on the number of tasks of `reduce()` (one partial
+/// result per task lives on the stack)
+constexpr std::size_t max_reduce_tasks = 64;
+
+/// @brief Assigns `x` to all elements
+/// @param bp Destination
+/// @param x Fill value
+/// @param exec Executor (e.g. `thread_pool&`)
+/// @param grain Preferred number of items per task
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A, typename Executor>
+inline void fill(bitpacker<T, W, N, E, A>& bp, T x, Executor&& exec,
+                 std::size_t grain = default_grain) {
+  using dispatcher = impl::type_dispatcher<T, W, N, E>;
+  using unsigned_type = typename dispatcher::unsigned_type;
+
+  auto bits = dispatcher::encode_value(static_cast<unsigned_type>(x));
+  auto mask0 = (std::uintmax_t)(bits & dispatcher::value_mask)
+               << dispatcher::front_offset;
+  auto full = dispatcher::template fill_word<dispatcher::per_word>(mask0);
+  auto last = dispatcher::template fill_word<dispatcher::last_word_items>(
+      mask0);
+  auto words = bp.data();
+
+  impl::split_items(
+      N, dispatcher::per_word, grain, max_tasks, exec,
+      [&](std::size_t, std::size_t first, std::size_t end) {
+        auto w = first / dispatcher::per_word;
+        auto w_end = dispatcher::words_for(end);
+
+        for (; w < w_end; ++w)
+          words[w] = w == dispatcher::word_count - 1 ? last : full;
+      });
+}
+
+/// @brief Copies all elements (word by word)
+/// @param src Source
+/// @param dst Destination
+/// @param exec Executor (e.g. `thread_pool&`)
+/// @param grain Preferred number of items per task
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A, std::size_t A2, typename Executor>
+inline void copy(const bitpacker<T, W, N, E, A>& src,
+                 bitpacker<T, W, N, E, A2>& dst, Executor&& exec,
+                 std::size_t grain = default_grain) {
+  using dispatcher = impl::type_dispatcher<T, W, N, E>;
+
+  auto from = src.data();
+  auto to = dst.data();
+
+  impl::split_items(N, dispatcher::per_word, grain, max_tasks, exec,
+                    [&](std::size_t, std::size_t first, std::size_t end) {
+                      auto w = first / dispatcher::per_word;
+                      auto w_end = dispatcher::words_for(end);
+
+                      for (; w < w_end; ++w) to[w] = from[w];
+                    });
+}
+
+/// @brief Stores `f(src[i])` into `dst[i]` for every element
+/// @param src Source
+/// @param dst Destination (may use another type, width or policy)
+/// @param f Callable as `f(T) -> U`
+/// @param exec Executor (e.g. `thread_pool&`)
+/// @param grain Preferred number of items per task
+template <typename T, std::size_t W, typename E, std::size_t A, typename U,
+          std::size_t W2, typename E2, std::size_t A2, std::size_t N,
+          typename F, typename Executor>
+inline void transform(const bitpacker<T, W, N, E, A>& src,
+                      bitpacker<U, W2, N, E2, A2>& dst, F&& f, Executor&& exec,
+                      std::size_t grain = default_grain) {
+  using src_lane = impl::lane_dispatcher<T, W, E>;
+  using dst_lane = impl::lane_dispatcher<U, W2, E2>;
+  using dst_unsigned = typename dst_lane::unsigned_type;
+
+  // Ranges start on a word boundary of both packers
+  constexpr auto align =
+      src_lane::per_word /
+      impl::gcd<src_lane::per_word, dst_lane::per_word>() * dst_lane::per_word;
+
+  const std::uintmax_t* from = src.data();
+  std::uintmax_t* to = dst.data();
+
+  impl::split_items(
+      N, align, grain, max_tasks, exec,
+      [&](std::size_t, std::size_t first, std::size_t end) {
+        for (auto pos = first; pos < end; ++pos) {
+          auto value = static_cast<T>(src_lane::extract_value(
+              &from[src_lane::word_index(pos)], src_lane::item_offset(pos)));
+
+          dst_lane::embed_value(&to[dst_lane::word_index(pos)],
+                                dst_lane::item_offset(pos),
+                                static_cast<dst_unsigned>(f(value)));
+        }
+      });
+}
+
+/// @brief Combines all elements in index order
+/// @param bp Source
+/// @param init Identity of `op` (e.g. 0 for addition); every task starts
+/// from it
+/// @param op Associative callable as `op(Acc, T) -> Acc` and
+/// `op(Acc, Acc) -> Acc` (partial results are combined in order)
+/// @param exec Executor (e.g. `thread_pool&`)
+/// @param grain Preferred number of items per task
+/// @return `init` combined with every element
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A, typename Acc, typename Op, typename Executor>
+inline Acc reduce(const bitpacker<T, W, N, E, A>& bp, Acc init, Op&& op,
+                  Executor&& exec, std::size_t grain = default_grain) {
+  using lane = impl::lane_dispatcher<T, W, E>;
+
+  const std::uintmax_t* words = bp.data();
+  auto partials = impl::filled_array(
+      init, std::make_index_sequence<max_reduce_tasks>{});
+
+  auto task_count = impl::split_items(
+      N, lane::per_word, grain, max_reduce_tasks, exec,
+      [&](std::size_t task, std::size_t first, std::size_t end) {
+        auto acc = init;
+
+        for (auto pos = first; pos < end;) {
+          auto word_ptr = &words[lane::word_index(pos)];
+          auto word_end = pos + lane::per_word < end ? pos + lane::per_word
+                                                     : end;
+
+          for (auto offset = lane::front_offset; pos < word_end;
+               ++pos, offset -= W)
+            acc = op(acc,
+                     static_cast<T>(lane::extract_value(word_ptr, offset)));
+        }
+
+        partials[task] = acc;
+      });
+
+  auto result = init;
+
+  for (std::size_t i = 0; i < task_count; ++i)
+    result = op(result, partials[i]);
+
+  return result;
+}
+
+/// @brief Counts elements that satisfy a predicate
+/// @param bp Source
+/// @param pred Callable as `pred(T) -> bool`
+/// @param exec Executor (e.g. `thread_pool&`)
+/// @param grain Preferred number of items per task
+/// @return Number of matching elements
+template <typename T, std::size_t W, std::size_t N, typename E,
+          std::size_t A, typename Pred, typename Executor>
+inline std::size_t count(const bitpacker<T, W, N, E, A>& bp, Pred&& pred,
+                         Executor&& exec, std::size_t grain = default_grain) {
+  using lane = impl::lane_dispatcher<T, W, E>;
+
+  const std::uintmax_t* words = bp.data();
+  std::atomic<std::size_t> total{0};
+
+  impl::split_items(
+      N, lane::per_word, grain, max_tasks, exec,
+      [&](std::size_t, std::size_t first, std::size_t end) {
+        std::size_t matches = 0;
+
+        for (auto pos = first; pos < end;) {
+          auto word_ptr = &words[lane::word_index(pos)];
+          auto word_end = pos + lane::per_word < end ? pos + lane::per_word
+                                                     : end;
+
+          for (auto offset = lane::front_offset; pos < word_end;
+               ++pos, offset -= W)
+            matches += (std::size_t)(bool)pred(
+                static_cast<T>(lane::extract_value(word_ptr, offset)));
+        }
+
+        total.fetch_add(matches, std::memory_order_relaxed);
+      });
+
+  return total.load(std::memory_order_relaxed);
+}
+
+}  // namespace bp3k::parallel
+
+#endif  // !_BITPACKER3000_PARALLEL_H_
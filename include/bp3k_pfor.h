@@ -0,0 +1,338 @@
+#ifndef _BITPACKER3000_PFOR_H_
+#define _BITPACKER3000_PFOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Patched frame-of-reference (PFOR) array
+/// @tparam T I/O value type (signed/unsigned integral type)
+/// @tparam B Number of values per block
+///
+/// Each block stores a base (its minimum) and packs `value - base` with its
+/// own width; values that do not fit are kept in a per-block exception list
+/// (position plus high bits) and patched in on decode. The width minimizes
+/// the block's total size, so rare outliers no longer widen every lane.
+template <typename T, std::size_t B = 128>
+class pfor_packer final {
+  static_assert(std::is_integral<T>::value, "T must be an integral type");
+  static_assert(B != 0 && B <= 1024, "B must be in [1, 1024]");
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  using lanes = impl::width_dispatcher;
+
+  static constexpr std::size_t t_width = sizeof(T) << 3;
+  static constexpr std::size_t exception_bits = t_width + 16;
+
+  /// @brief Encoding parameters of one block
+  struct block_header {
+    T base;
+    std::uint8_t width;
+    std::uint16_t exception_count;
+    std::size_t word_offset;
+    std::size_t exception_offset;
+  };
+
+  impl::heap_array<block_header> blocks_{};
+  impl::word_buffer words_{};
+  impl::heap_array<std::uint16_t> exception_pos_{};
+  impl::heap_array<unsigned_type> exception_high_{};
+  std::size_t size_{};
+  std::size_t word_count_{};
+  std::size_t exception_count_{};
+
+  /// @brief Computes `value - base` for each value of a block
+  /// @param values Pointer to first value of the block
+  /// @param len Number of values in the block
+  /// @param base Block base
+  /// @param offsets Output offsets
+  static inline void compute_offsets(const T* values, std::size_t len, T base,
+                                     unsigned_type* offsets) noexcept {
+    for (std::size_t i = 0; i < len; ++i)
+      offsets[i] =
+          (unsigned_type)((unsigned_type)values[i] - (unsigned_type)base);
+  }
+
+  /// @brief Chooses base and width for one block
+  /// @param values Pointer to first value of the block
+  /// @param len Number of values in the block
+  /// @param offsets Output: `value - base` for each value
+  /// @return Header (offsets within the buffers are left zero)
+  static inline block_header analyze(const T* values, std::size_t len,
+                                     unsigned_type* offsets) noexcept {
+    T lo = values[0];
+
+    for (std::size_t i = 1; i < len; ++i) lo = values[i] < lo ? values[i] : lo;
+
+    std::size_t histogram[t_width + 1]{};
+
+    compute_offsets(values, len, lo, offsets);
+
+    for (std::size_t i = 0; i < len; ++i)
+      ++histogram[impl::bit_width(offsets[i])];
+
+    std::size_t best_width = t_width, best_cost = len * t_width;
+    std::size_t best_exceptions = 0, above = 0;
+
+    for (std::size_t w = t_width; w-- > 0;) {
+      above += histogram[w + 1];
+      auto cost = len * w + above * exception_bits;
+
+      if (cost < best_cost) {
+        best_width = w;
+        best_cost = cost;
+        best_exceptions = above;
+      }
+    }
+
+    return block_header{lo, (std::uint8_t)best_width,
+                        (std::uint16_t)best_exceptions, 0, 0};
+  }
+
+  /// @brief Fetches block length
+  inline std::size_t block_length(std::size_t block) const noexcept {
+    auto first = block * B;
+    return first + B < this->size_ ? B : this->size_ - first;
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of values per block
+  static constexpr std::size_t block_size = B;
+
+  /// @brief Default constructor (no allocation)
+  pfor_packer() = default;
+
+  /// @brief Constructor (no allocation)
+  /// @param resource Source of storage (null for the global heap)
+  inline explicit pfor_packer(std::pmr::memory_resource* resource) noexcept
+      : blocks_(resource),
+        words_(resource),
+        exception_pos_(resource),
+        exception_high_(resource) {}
+
+  pfor_packer(const pfor_packer&) = delete;
+  pfor_packer& operator=(const pfor_packer&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Packer to take ownership from
+  inline pfor_packer(pfor_packer&& other) noexcept { this->swap(other); }
+
+  /// @brief Move assignment
+  /// @param other Packer to take ownership from
+  /// @return Self reference
+  inline pfor_packer& operator=(pfor_packer&& other) noexcept {
+    pfor_packer tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents of the container with those of `other`
+  /// @param other Packer to swap with
+  inline void swap(pfor_packer& other) noexcept {
+    std::swap(this->size_, other.size_);
+    std::swap(this->word_count_, other.word_count_);
+    std::swap(this->exception_count_, other.exception_count_);
+    this->blocks_.swap(other.blocks_);
+    this->words_.swap(other.words_);
+    this->exception_pos_.swap(other.exception_pos_);
+    this->exception_high_.swap(other.exception_high_);
+  }
+
+  /// @brief Encodes a sequence, replacing the current contents
+  /// @param values Pointer to first input value
+  /// @param count Number of input values
+  /// @return `false` if allocation failed (contents are left untouched)
+  inline bool encode(const T* values, std::size_t count) noexcept {
+    auto block_count = (count + B - 1) / B;
+    auto resource = this->resource();
+    impl::heap_array<block_header> blocks(resource);
+    unsigned_type offsets[B];
+
+    if (!blocks.allocate(block_count)) return false;
+
+    std::size_t word_total = 0, exception_total = 0;
+
+    for (std::size_t b = 0; b < block_count; ++b) {
+      auto len = b * B + B < count ? B : count - b * B;
+      auto& header = blocks.data()[b];
+
+      header = analyze(&values[b * B], len, offsets);
+      header.word_offset = word_total;
+      header.exception_offset = exception_total;
+
+      if (header.width != 0) word_total += lanes::words_for(len, header.width);
+      exception_total += header.exception_count;
+    }
+
+    impl::word_buffer words(resource);
+    impl::heap_array<std::uint16_t> exception_pos(resource);
+    impl::heap_array<unsigned_type> exception_high(resource);
+
+    if (!words.allocate(word_total) ||
+        !exception_pos.allocate(exception_total) ||
+        !exception_high.allocate(exception_total))
+      return false;
+
+    for (std::size_t b = 0; b < block_count; ++b) {
+      auto len = b * B + B < count ? B : count - b * B;
+      const auto& header = blocks.data()[b];
+      auto e = header.exception_offset;
+
+      compute_offsets(&values[b * B], len, header.base, offsets);
+
+      if (header.width == t_width) {
+        lanes::pack(offsets, len, t_width, &words.data()[header.word_offset]);
+        continue;
+      }
+
+      for (std::size_t i = 0; i < len; ++i) {
+        auto high = (unsigned_type)(offsets[i] >> header.width);
+        if (high == 0) continue;
+
+        exception_pos.data()[e] = (std::uint16_t)i;
+        exception_high.data()[e++] = high;
+      }
+
+      if (header.width != 0)
+        lanes::pack(offsets, len, header.width,
+                    &words.data()[header.word_offset]);
+    }
+
+    this->blocks_ = std::move(blocks);
+    this->words_ = std::move(words);
+    this->exception_pos_ = std::move(exception_pos);
+    this->exception_high_ = std::move(exception_high);
+    this->size_ = count;
+    this->word_count_ = word_total;
+    this->exception_count_ = exception_total;
+    return true;
+  }
+
+  /// @brief Decodes all values
+  /// @param out Pointer to `size()` output values
+  inline void decode(T* out) const noexcept {
+    unsigned_type offsets[B];
+
+    for (std::size_t b = 0; b < this->block_count(); ++b) {
+      const auto& header = this->blocks_.data()[b];
+      auto len = this->block_length(b);
+
+      if (header.width == 0) {
+        for (std::size_t i = 0; i < len; ++i) offsets[i] = 0;
+      } else {
+        lanes::unpack(&this->words_.data()[header.word_offset], len,
+                      header.width, offsets);
+      }
+
+      auto e = header.exception_offset;
+      auto e_end = e + header.exception_count;
+
+      for (; e < e_end; ++e)
+        offsets[this->exception_pos_.data()[e]] |=
+            (unsigned_type)(this->exception_high_.data()[e] << header.width);
+
+      for (std::size_t i = 0; i < len; ++i)
+        out[b * B + i] = (T)((unsigned_type)header.base + offsets[i]);
+    }
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T at(std::size_t pos) const noexcept {
+    const auto& header = this->blocks_.data()[pos / B];
+    auto i = pos % B;
+    unsigned_type offset = 0;
+
+    if (header.width != 0)
+      offset = (unsigned_type)lanes::extract_value(
+          &this->words_.data()[header.word_offset], i, header.width);
+
+    // Exceptions are sorted by position: binary search within the block
+    auto lo = header.exception_offset;
+    auto hi = lo + header.exception_count;
+
+    while (lo < hi) {
+      auto mid = lo + ((hi - lo) >> 1);
+      auto mid_pos = (std::size_t)this->exception_pos_.data()[mid];
+
+      if (mid_pos == i) {
+        offset |=
+            (unsigned_type)(this->exception_high_.data()[mid] << header.width);
+        break;
+      }
+
+      if (mid_pos < i)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    return (T)((unsigned_type)header.base + offset);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T operator[](std::size_t pos) const noexcept { return this->at(pos); }
+
+  /// @brief Checks if the container has no elements
+  /// @return `true` if the container is empty, `false` otherwise
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of elements in the container
+  /// @return Element count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Returns the number of blocks
+  /// @return Block count
+  inline std::size_t block_count() const noexcept {
+    return (this->size_ + B - 1) / B;
+  }
+
+  /// @brief Fetches the packed width chosen for a block
+  /// @param block Index of block
+  /// @return Bit width (0 if all values equal the block's base)
+  inline std::size_t block_width(std::size_t block) const noexcept {
+    return this->blocks_.data()[block].width;
+  }
+
+  /// @brief Returns the total number of exceptions
+  /// @return Exception count
+  inline std::size_t exception_count() const noexcept {
+    return this->exception_count_;
+  }
+
+  /// @brief Returns the number of packed words
+  /// @return Word count
+  inline std::size_t word_count() const noexcept { return this->word_count_; }
+
+  /// @brief Returns the encoded footprint (headers, words and exceptions)
+  /// @return Byte count
+  inline std::size_t bytes_used() const noexcept {
+    return this->block_count() * sizeof(block_header) +
+           this->word_count_ * sizeof(std::uintmax_t) +
+           this->exception_count_ *
+               (sizeof(std::uint16_t) + sizeof(unsigned_type));
+  }
+
+  /// @brief Returns the source of storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->words_.resource();
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_PFOR_H_
@@ -0,0 +1,244 @@
+#ifndef _BITPACKER3000_SEQLOCK_H_
+#define _BITPACKER3000_SEQLOCK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "bp3k.h"
+#include "bp3k_atomic.h"
+
+namespace bp3k::impl {
+
+/// @brief Sequence counter alone on its cache line
+struct alignas(cache_line_size) padded_sequence final {
+  std::atomic<std::size_t> value;
+};
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Fixed-size packed array with one writer and lock-free readers
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam N Packed-value capacity
+/// @tparam BlockWords Number of words guarded by each sequence counter
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// Words use the `bitpacker` layout and are split into blocks of
+/// `BlockWords` words (one cache line by default), each with a sequence
+/// counter (padded to its own cache line) that is odd while the writer is
+/// changing the block. Readers copy a range optimistically and retry if a
+/// counter was odd or moved, so a multi-item read (e.g. a whole row) is
+/// never torn and never takes a lock. Only one thread may call the writing
+/// members at a time.
+template <typename T, std::size_t W, std::size_t N,
+          std::size_t BlockWords = cache_line_size / sizeof(std::uintmax_t),
+          typename E = twos_complement>
+class seqlock_packer final {
+  static_assert(N != 0, "N must be non-zero");
+  static_assert(BlockWords != 0, "BlockWords must be non-zero");
+
+  using lane = impl::lane_dispatcher<T, W, E>;
+  using unsigned_type = typename lane::unsigned_type;
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Storage policy
+  using encoding_type = E;
+
+  /// @brief Minimum value of T with width W
+  static constexpr T value_min = lane::value_min();
+
+  /// @brief Maximum value of T with width W
+  static constexpr T value_max = lane::value_max();
+
+  /// @brief Number of storage words
+  static constexpr std::size_t word_count = lane::words_for(N);
+
+  /// @brief Number of items guarded by one sequence counter
+  static constexpr std::size_t block_items = BlockWords * lane::per_word;
+
+  /// @brief Number of sequence counters
+  static constexpr std::size_t block_count =
+      (word_count + BlockWords - 1) / BlockWords;
+
+ private:
+  alignas(cache_line_size) std::uintmax_t data_[word_count]{};
+  // One line per counter: bumping a block never invalidates its neighbours
+  impl::padded_sequence seq_[block_count]{};
+
+  /// @brief Makes the counters of blocks `[first, last]` odd
+  inline void begin_write(std::size_t first, std::size_t last) noexcept {
+    for (auto b = first; b <= last; ++b) {
+      auto& seq = this->seq_[b].value;
+      seq.store(seq.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    }
+
+    // Orders the odd counters before any word store
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  /// @brief Makes the counters of blocks `[first, last]` even again
+  inline void end_write(std::size_t first, std::size_t last) noexcept {
+    for (auto b = first; b <= last; ++b) {
+      auto& seq = this->seq_[b].value;
+      seq.store(seq.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+    }
+  }
+
+  /// @brief Stores `value_at(i)` into item `pos + i` for `i < count`
+  template <typename F>
+  inline void write_items(std::size_t pos, std::size_t count,
+                          F&& value_at) noexcept {
+    if (count == 0) return;
+
+    auto first = pos / block_items;
+    auto last = (pos + count - 1) / block_items;
+    std::size_t i = 0;
+
+    this->begin_write(first, last);
+
+    while (i < count) {
+      auto word_ptr = &this->data_[lane::word_index(pos + i)];
+      auto word = *word_ptr;
+
+      do {
+        lane::embed_value(&word, lane::item_offset(pos + i),
+                          (unsigned_type)value_at(i));
+        ++i;
+      } while (i < count && lane::item_offset(pos + i) != lane::front_offset);
+
+      impl::store_word(word_ptr, word);
+    }
+
+    this->end_write(first, last);
+  }
+
+  /// @brief Decodes items from racy word loads (validated by the caller)
+  inline void copy_items(std::size_t pos, std::size_t count,
+                         T* out) const noexcept {
+    while (count != 0) {
+      auto word = impl::load_word(&this->data_[lane::word_index(pos)]);
+
+      do {
+        *out++ = static_cast<T>(
+            lane::extract_value(&word, lane::item_offset(pos)));
+        ++pos;
+        --count;
+      } while (count != 0 && lane::item_offset(pos) != lane::front_offset);
+    }
+  }
+
+ public:
+  /// @brief Default constructor (all items zero)
+  seqlock_packer() = default;
+
+  seqlock_packer(const seqlock_packer&) = delete;
+  seqlock_packer& operator=(const seqlock_packer&) = delete;
+
+  /// @brief Fetches value of one item (no retry: items never straddle words)
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T load(std::size_t pos) const noexcept {
+    auto word = impl::load_word(&this->data_[lane::word_index(pos)]);
+    return static_cast<T>(lane::extract_value(&word, lane::item_offset(pos)));
+  }
+
+  /// @brief Fetches value of one item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T operator[](std::size_t pos) const noexcept {
+    return this->load(pos);
+  }
+
+  /// @brief Makes one attempt at a consistent copy of consecutive items
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values (clobbered even when the attempt fails)
+  /// @return `false` if the writer touched the range meanwhile
+  inline bool try_read(std::size_t pos, std::size_t count,
+                       T* out) const noexcept {
+    if (count == 0) return true;
+
+    auto first = pos / block_items;
+    auto last = (pos + count - 1) / block_items;
+    std::size_t before = 0, after = 0;
+
+    for (auto b = first; b <= last; ++b) {
+      auto seq = this->seq_[b].value.load(std::memory_order_acquire);
+
+      if ((seq & 1) != 0) return false;
+
+      before += seq;
+    }
+
+    this->copy_items(pos, count, out);
+
+    // Orders the word loads before the counters are checked again
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    for (auto b = first; b <= last; ++b)
+      after += this->seq_[b].value.load(std::memory_order_relaxed);
+
+    // Counters never decrease, so equal sums mean none of them moved
+    return after == before;
+  }
+
+  /// @brief Copies consecutive items, retrying until the copy is consistent
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  /// @return Number of failed attempts
+  inline std::size_t read(std::size_t pos, std::size_t count,
+                          T* out) const noexcept {
+    std::size_t retries = 0;
+
+    while (!this->try_read(pos, count, out)) ++retries;
+
+    return retries;
+  }
+
+  /// @brief Fetches the sequence counter of the block holding an item
+  /// @param pos Index of item
+  /// @return Counter (odd while a write is in progress)
+  inline std::size_t version(std::size_t pos) const noexcept {
+    return this->seq_[pos / block_items].value.load(std::memory_order_acquire);
+  }
+
+  /// @brief Stores a value (writer only)
+  /// @param pos Index of item
+  /// @param x Value
+  inline void store(std::size_t pos, T x) noexcept {
+    this->write_items(pos, 1, [x](std::size_t) { return x; });
+  }
+
+  /// @brief Stores consecutive items as one update (writer only)
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param values Input values
+  inline void write(std::size_t pos, std::size_t count,
+                    const T* values) noexcept {
+    this->write_items(pos, count,
+                      [values](std::size_t i) { return values[i]; });
+  }
+
+  /// @brief Assigns `x` to every item as one update (writer only)
+  /// @param x The value to assign
+  inline void fill(T x) noexcept {
+    this->write_items(0, N, [x](std::size_t) { return x; });
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return Element count
+  inline constexpr std::size_t size() const noexcept { return N; }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SEQLOCK_H_
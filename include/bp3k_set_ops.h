@@ -0,0 +1,356 @@
+#ifndef _BITPACKER3000_SET_OPS_H_
+#define _BITPACKER3000_SET_OPS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bp3k.h"
+
+namespace bp3k::impl {
+
+/// @brief Sequential reader that decodes packed items a block at a time
+/// @tparam T I/O value type
+/// @tparam W Bit width of packed values
+/// @tparam E Storage policy
+template <typename T, std::size_t W, typename E>
+class packed_cursor final {
+  using lane = lane_dispatcher<T, W, E>;
+
+ public:
+  /// @brief Number of items decoded per refill
+  static constexpr std::size_t block_size = 64;
+
+ private:
+  const std::uintmax_t* words_;
+  std::size_t size_;
+  /// @brief Index of the first item not yet decoded
+  std::size_t next_{};
+  std::size_t pos_{};
+  std::size_t len_{};
+  T buffer_[block_size]{};
+
+  inline void refill() noexcept {
+    auto rest = this->size_ - this->next_;
+
+    this->len_ = rest < block_size ? rest : block_size;
+    this->pos_ = 0;
+    lane::unpack(this->words_, this->next_, this->len_, this->buffer_);
+    this->next_ += this->len_;
+  }
+
+ public:
+  /// @brief Constructor
+  /// @param words Pointer to first word
+  /// @param size Number of items
+  inline packed_cursor(const std::uintmax_t* words, std::size_t size) noexcept
+      : words_(words), size_(size) {
+    this->refill();
+  }
+
+  /// @brief Checks if every item has been consumed
+  inline bool done() const noexcept { return this->pos_ == this->len_; }
+
+  /// @brief Returns the current item
+  inline T peek() const noexcept { return this->buffer_[this->pos_]; }
+
+  /// @brief Returns the last item of the decoded block
+  inline T block_back() const noexcept {
+    return this->buffer_[this->len_ - 1];
+  }
+
+  /// @brief Moves to the next item
+  inline void advance() noexcept {
+    if (++this->pos_ == this->len_ && this->next_ < this->size_)
+      this->refill();
+  }
+
+  /// @brief Drops the rest of the decoded block
+  /// @tparam F Callable as `f(T)` receiving every dropped item
+  template <typename F>
+  inline void drain_block(F&& f) noexcept {
+    for (; this->pos_ < this->len_; ++this->pos_) f(this->buffer_[this->pos_]);
+
+    if (this->next_ < this->size_) this->refill();
+  }
+};
+
+/// @brief Appends items to a word buffer in `bitpacker` layout
+/// @tparam T I/O value type
+/// @tparam W Bit width of packed values
+/// @tparam E Storage policy
+template <typename T, std::size_t W, typename E>
+class packed_appender final {
+  using lane = lane_dispatcher<T, W, E>;
+  using unsigned_type = typename lane::unsigned_type;
+
+  std::uintmax_t* words_;
+  std::size_t word_count_;
+  std::size_t size_{};
+  std::size_t word_pos_{};
+  std::uintmax_t word_{};
+  std::size_t offset_{lane::front_offset};
+
+ public:
+  /// @brief Constructor
+  /// @param words Pointer to first output word
+  /// @param word_count Number of output words
+  inline packed_appender(std::uintmax_t* words, std::size_t word_count) noexcept
+      : words_(words), word_count_(word_count) {}
+
+  /// @brief Appends an item
+  inline void push(T x) noexcept {
+    auto bits = lane::encode_value(static_cast<unsigned_type>(x));
+    this->word_ |= (std::uintmax_t)(bits & lane::value_mask) << this->offset_;
+    ++this->size_;
+
+    if (this->offset_ < W) {
+      this->words_[this->word_pos_++] = this->word_;
+      this->word_ = 0;
+      this->offset_ = lane::front_offset;
+    } else {
+      this->offset_ -= W;
+    }
+  }
+
+  /// @brief Stores the partial word and clears the remaining words
+  /// @return Number of items appended
+  inline std::size_t finish() noexcept {
+    if (this->offset_ != lane::front_offset)
+      this->words_[this->word_pos_++] = this->word_;
+
+    for (auto i = this->word_pos_; i < this->word_count_; ++i)
+      this->words_[i] = 0;
+
+    return this->size_;
+  }
+};
+
+/// @brief Finds the first item not less than `x` at or after `first`
+///
+/// Probes `first + 1, +2, +4, ...` before a binary search, so the cost
+/// grows with the distance skipped rather than the array length.
+template <typename T, std::size_t W, typename E>
+inline std::size_t gallop(const std::uintmax_t* words, std::size_t size,
+                          std::size_t first, T x) noexcept {
+  using lane = lane_dispatcher<T, W, E>;
+
+  auto get = [words](std::size_t pos) {
+    return static_cast<T>(lane::extract_value(&words[lane::word_index(pos)],
+                                              lane::item_offset(pos)));
+  };
+
+  if (first >= size || !(get(first) < x)) return first;
+
+  std::size_t below = first, step = 1;
+
+  while (below + step < size && get(below + step) < x) {
+    below += step;
+    step <<= 1;
+  }
+
+  auto lo = below + 1;
+  auto hi = below + step < size ? below + step : size;
+
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+
+    if (get(mid) < x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/// @brief Size ratio above which `intersect()` gallops through the larger
+/// input instead of merging
+constexpr std::size_t gallop_ratio = 32;
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Intersects two sorted packed arrays (`std::set_intersection`
+/// semantics)
+/// @param a First input (sorted ascending)
+/// @param b Second input (sorted ascending)
+/// @param out Output; previous contents are replaced (unused items are zero)
+/// @param a_count Number of items of `a` to use
+/// @param b_count Number of items of `b` to use
+/// @return Number of items written
+template <typename T, std::size_t W, typename E, std::size_t N1,
+          std::size_t N2, std::size_t M, std::size_t A1, std::size_t A2,
+          std::size_t A3>
+inline std::size_t intersect(const bitpacker<T, W, N1, E, A1>& a,
+                             const bitpacker<T, W, N2, E, A2>& b,
+                             bitpacker<T, W, M, E, A3>& out,
+                             std::size_t a_count = N1,
+                             std::size_t b_count = N2) noexcept {
+  static_assert(M >= (N1 < N2 ? N1 : N2), "out cannot hold the result");
+
+  using cursor = impl::packed_cursor<T, W, E>;
+
+  impl::packed_appender<T, W, E> result(
+      out.data(), impl::type_dispatcher<T, W, M, E>::word_count);
+
+  if (a_count == 0 || b_count == 0) return result.finish();
+
+  // Very different sizes: look up each item of the smaller side
+  if (a_count * impl::gallop_ratio < b_count ||
+      b_count * impl::gallop_ratio < a_count) {
+    auto small_words = a_count <= b_count ? a.data() : b.data();
+    auto large_words = a_count <= b_count ? b.data() : a.data();
+    auto small_count = a_count <= b_count ? a_count : b_count;
+    auto large_count = a_count <= b_count ? b_count : a_count;
+    std::size_t pos = 0;
+
+    for (cursor it(small_words, small_count); !it.done(); it.advance()) {
+      auto x = it.peek();
+
+      pos = impl::gallop<T, W, E>(large_words, large_count, pos, x);
+      if (pos == large_count) break;
+
+      auto y = static_cast<T>(impl::lane_dispatcher<T, W, E>::extract_value(
+          &large_words[impl::lane_dispatcher<T, W, E>::word_index(pos)],
+          impl::lane_dispatcher<T, W, E>::item_offset(pos)));
+
+      if (!(x < y)) {
+        result.push(x);
+        ++pos;
+      }
+    }
+
+    return result.finish();
+  }
+
+  cursor ia(a.data(), a_count), ib(b.data(), b_count);
+  auto discard = [](T) {};
+
+  while (!ia.done() && !ib.done()) {
+    // Whole decoded blocks below the other side cannot match
+    if (ia.block_back() < ib.peek()) {
+      ia.drain_block(discard);
+    } else if (ib.block_back() < ia.peek()) {
+      ib.drain_block(discard);
+    } else if (ia.peek() < ib.peek()) {
+      ia.advance();
+    } else if (ib.peek() < ia.peek()) {
+      ib.advance();
+    } else {
+      result.push(ia.peek());
+      ia.advance();
+      ib.advance();
+    }
+  }
+
+  return result.finish();
+}
+
+/// @brief Merges two sorted packed arrays (`std::set_union` semantics)
+/// @param a First input (sorted ascending)
+/// @param b Second input (sorted ascending)
+/// @param out Output; previous contents are replaced (unused items are zero)
+/// @param a_count Number of items of `a` to use
+/// @param b_count Number of items of `b` to use
+/// @return Number of items written
+template <typename T, std::size_t W, typename E, std::size_t N1,
+          std::size_t N2, std::size_t M, std::size_t A1, std::size_t A2,
+          std::size_t A3>
+inline std::size_t unite(const bitpacker<T, W, N1, E, A1>& a,
+                         const bitpacker<T, W, N2, E, A2>& b,
+                         bitpacker<T, W, M, E, A3>& out,
+                         std::size_t a_count = N1,
+                         std::size_t b_count = N2) noexcept {
+  static_assert(M >= N1 + N2, "out cannot hold the result");
+
+  using cursor = impl::packed_cursor<T, W, E>;
+
+  impl::packed_appender<T, W, E> result(
+      out.data(), impl::type_dispatcher<T, W, M, E>::word_count);
+  auto emit = [&result](T x) { result.push(x); };
+
+  if (a_count == 0 && b_count == 0) return result.finish();
+
+  cursor ia(a.data(), a_count), ib(b.data(), b_count);
+
+  while (!ia.done() && !ib.done()) {
+    if (ia.block_back() < ib.peek()) {
+      ia.drain_block(emit);
+    } else if (ib.block_back() < ia.peek()) {
+      ib.drain_block(emit);
+    } else if (ia.peek() < ib.peek()) {
+      result.push(ia.peek());
+      ia.advance();
+    } else if (ib.peek() < ia.peek()) {
+      result.push(ib.peek());
+      ib.advance();
+    } else {
+      result.push(ia.peek());
+      ia.advance();
+      ib.advance();
+    }
+  }
+
+  while (!ia.done()) ia.drain_block(emit);
+  while (!ib.done()) ib.drain_block(emit);
+
+  return result.finish();
+}
+
+/// @brief Keeps items of `a` not in `b` (`std::set_difference` semantics)
+/// @param a First input (sorted ascending)
+/// @param b Second input (sorted ascending)
+/// @param out Output; previous contents are replaced (unused items are zero)
+/// @param a_count Number of items of `a` to use
+/// @param b_count Number of items of `b` to use
+/// @return Number of items written
+template <typename T, std::size_t W, typename E, std::size_t N1,
+          std::size_t N2, std::size_t M, std::size_t A1, std::size_t A2,
+          std::size_t A3>
+inline std::size_t difference(const bitpacker<T, W, N1, E, A1>& a,
+                              const bitpacker<T, W, N2, E, A2>& b,
+                              bitpacker<T, W, M, E, A3>& out,
+                              std::size_t a_count = N1,
+                              std::size_t b_count = N2) noexcept {
+  static_assert(M >= N1, "out cannot hold the result");
+
+  using cursor = impl::packed_cursor<T, W, E>;
+
+  impl::packed_appender<T, W, E> result(
+      out.data(), impl::type_dispatcher<T, W, M, E>::word_count);
+  auto emit = [&result](T x) { result.push(x); };
+  auto discard = [](T) {};
+
+  if (a_count == 0) return result.finish();
+
+  cursor ia(a.data(), a_count);
+
+  if (b_count != 0) {
+    cursor ib(b.data(), b_count);
+
+    while (!ia.done() && !ib.done()) {
+      if (ia.block_back() < ib.peek()) {
+        ia.drain_block(emit);
+      } else if (ib.block_back() < ia.peek()) {
+        ib.drain_block(discard);
+      } else if (ia.peek() < ib.peek()) {
+        result.push(ia.peek());
+        ia.advance();
+      } else if (ib.peek() < ia.peek()) {
+        ib.advance();
+      } else {
+        ia.advance();
+        ib.advance();
+      }
+    }
+  }
+
+  while (!ia.done()) ia.drain_block(emit);
+
+  return result.finish();
+}
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SET_OPS_H_
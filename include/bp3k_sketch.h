@@ -0,0 +1,460 @@
+#ifndef _BITPACKER3000_SKETCH_H_
+#define _BITPACKER3000_SKETCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bp3k.h"
+#include "bp3k_atomic.h"
+#include "bp3k_detail.h"
+
+namespace bp3k::impl {
+
+/// @brief Fixed array of W-bit saturating counters in `bitpacker` layout
+/// @tparam W Bit width of each counter
+/// @tparam Cells Number of counters
+///
+/// `*_atomic` members may run concurrently with each other; the plain
+/// members must not overlap any of them.
+template <std::size_t W, std::size_t Cells>
+class counter_array final {
+  using value_type = fit_unsigned<W>;
+  using packer = bitpacker<value_type, W, Cells>;
+  using dispatcher = type_dispatcher<value_type, W, Cells>;
+
+  /// @brief Counter bits that survive a halving shift
+  static constexpr std::uintmax_t halve_mask =
+      dispatcher::template fill_word<dispatcher::per_word>(
+          (std::uintmax_t)(dispatcher::value_mask >> 1)
+          << dispatcher::front_offset);
+
+  packer cells_{};
+
+ public:
+  /// @brief Largest value a counter can hold
+  static constexpr value_type counter_max = packer::value_max;
+
+  /// @brief Reads a counter
+  /// @param pos Counter index
+  /// @return Counter value
+  inline value_type get(std::size_t pos) const noexcept {
+    return this->cells_[pos];
+  }
+
+  /// @brief Thread-safe `get()` (atomic word load)
+  /// @param pos Counter index
+  /// @return Counter value
+  inline value_type get_atomic(std::size_t pos) const noexcept {
+    auto word = load_word(&this->cells_.data()[dispatcher::word_index(pos)]);
+    return (value_type)dispatcher::extract_value(&word,
+                                                 dispatcher::item_offset(pos));
+  }
+
+  /// @brief Finds the smallest of several counters
+  /// @tparam Atomic `true` to read through `get_atomic()`
+  /// @param positions Counter indices
+  /// @param count Number of indices
+  /// @return Smallest value (`counter_max` if `count` is 0)
+  template <bool Atomic>
+  inline value_type smallest(const std::size_t* positions,
+                             std::size_t count) const noexcept {
+    value_type result = counter_max;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      auto value = Atomic ? this->get_atomic(positions[i])
+                          : this->get(positions[i]);
+      result = value < result ? value : result;
+    }
+
+    return result;
+  }
+
+  /// @brief Adds one unless the counter is saturated
+  /// @param pos Counter index
+  inline void increment(std::size_t pos) noexcept {
+    auto word = &this->cells_.data()[dispatcher::word_index(pos)];
+    auto offset = dispatcher::item_offset(pos);
+    auto value = (value_type)dispatcher::extract_value(word, offset);
+
+    dispatcher::embed_value(
+        word, offset, (value_type)(value + (value_type)(value != counter_max)));
+  }
+
+  /// @brief Subtracts one unless the counter is zero or saturated
+  ///
+  /// Saturated counters stick: their true count is unknown.
+  /// @param pos Counter index
+  inline void decrement(std::size_t pos) noexcept {
+    auto word = &this->cells_.data()[dispatcher::word_index(pos)];
+    auto offset = dispatcher::item_offset(pos);
+    auto value = (value_type)dispatcher::extract_value(word, offset);
+    auto live = (value_type)(value != 0 && value != counter_max);
+
+    dispatcher::embed_value(word, offset, (value_type)(value - live));
+  }
+
+  /// @brief Thread-safe `increment()` (compare-and-swap on the word)
+  /// @param pos Counter index
+  inline void increment_atomic(std::size_t pos) noexcept {
+    auto word = &this->cells_.data()[dispatcher::word_index(pos)];
+    auto offset = dispatcher::item_offset(pos);
+    auto old = load_word(word);
+
+    for (;;) {
+      auto value = (old >> offset) & dispatcher::value_mask;
+      if (value == counter_max) return;
+
+      // No carry can leave the lane below its maximum
+      if (compare_exchange_word(word, old, old + ((std::uintmax_t)1 << offset)))
+        return;
+    }
+  }
+
+  /// @brief Thread-safe `decrement()` (compare-and-swap on the word)
+  /// @param pos Counter index
+  inline void decrement_atomic(std::size_t pos) noexcept {
+    auto word = &this->cells_.data()[dispatcher::word_index(pos)];
+    auto offset = dispatcher::item_offset(pos);
+    auto old = load_word(word);
+
+    for (;;) {
+      auto value = (old >> offset) & dispatcher::value_mask;
+      if (value == 0 || value == counter_max) return;
+
+      if (compare_exchange_word(word, old, old - ((std::uintmax_t)1 << offset)))
+        return;
+    }
+  }
+
+  /// @brief Halves every counter (rounding down), one word at a time
+  ///
+  /// Not thread-safe: use `halve_atomic()` alongside atomic updates.
+  inline void halve() noexcept {
+    auto words = this->cells_.data();
+
+    for (std::size_t i = 0; i < dispatcher::word_count; ++i)
+      words[i] = (words[i] >> 1) & halve_mask;
+  }
+
+  /// @brief Thread-safe `halve()` (compare-and-swap on each word)
+  ///
+  /// Each word is halved atomically; the array as a whole is not a
+  /// snapshot, so concurrent updates may land before or after the halving.
+  inline void halve_atomic() noexcept {
+    auto words = this->cells_.data();
+
+    for (std::size_t i = 0; i < dispatcher::word_count; ++i) {
+      auto old = load_word(&words[i]);
+
+      while (!compare_exchange_word(&words[i], old, (old >> 1) & halve_mask)) {
+      }
+    }
+  }
+
+  /// @brief Resets every counter to zero
+  inline void clear() noexcept { this->cells_.fill(0); }
+
+  /// @brief Hints that a counter is about to be updated
+  /// @param pos Counter index
+  inline void prefetch(std::size_t pos) const noexcept {
+    impl::prefetch<true>(&this->cells_.data()[dispatcher::word_index(pos)]);
+  }
+};
+
+/// @brief Number of keys whose probes are computed (and prefetched) at once
+constexpr std::size_t sketch_batch_size = 16;
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Counting Bloom filter with W-bit saturating counters
+/// @tparam W Bit width of each counter (e.g. 4 or 8)
+/// @tparam Cells Number of counters
+/// @tparam K Number of probes per key
+///
+/// Keys are 64-bit values (hash or integer keys); probe `i` of a key is
+/// `(h1 + i * h2) % Cells` for two hashes derived from it. Packing
+/// `64 / W` counters per word raises the cells per cache line and thus
+/// lowers the false-positive rate at fixed memory.
+///
+/// While any thread calls a `*_atomic` member, every other thread must use
+/// `*_atomic` members too (`count_atomic()`, `contains_atomic()`, ...).
+template <std::size_t W, std::size_t Cells, std::size_t K = 4>
+class counting_bloom final {
+  static_assert(Cells != 0, "Cells must be non-zero");
+  static_assert(K != 0 && K <= 16, "K must be in [1, 16]");
+
+  using counters = impl::counter_array<W, Cells>;
+
+  counters cells_{};
+
+  /// @brief Computes the probes of a key
+  static inline void probes(std::uint64_t key, std::size_t* out) noexcept {
+    auto h1 = impl::mix64(key);
+    auto h2 = impl::mix64(h1) | 1;
+
+    for (std::size_t i = 0; i < K; ++i)
+      out[i] = (std::size_t)((h1 + i * h2) % Cells);
+  }
+
+  /// @brief Applies `f(pos)` to every probe of a batch of keys
+  template <typename F>
+  inline void for_each_probe(const std::uint64_t* keys, std::size_t count,
+                             F&& f) {
+    std::size_t positions[impl::sketch_batch_size * K];
+
+    for (std::size_t base = 0; base < count;
+         base += impl::sketch_batch_size) {
+      auto n = count - base < impl::sketch_batch_size
+                   ? count - base
+                   : impl::sketch_batch_size;
+
+      // All probes of the batch are in flight before the first update
+      for (std::size_t i = 0; i < n; ++i) {
+        probes(keys[base + i], &positions[i * K]);
+
+        for (std::size_t j = 0; j < K; ++j)
+          this->cells_.prefetch(positions[i * K + j]);
+      }
+
+      for (std::size_t i = 0; i < n * K; ++i) f(positions[i]);
+    }
+  }
+
+ public:
+  /// @brief Counter type
+  using value_type = impl::fit_unsigned<W>;
+
+  /// @brief Largest value a counter can hold
+  static constexpr value_type counter_max = counters::counter_max;
+
+  /// @brief Number of counters
+  static constexpr std::size_t cell_count = Cells;
+
+  /// @brief Number of probes per key
+  static constexpr std::size_t probe_count = K;
+
+  /// @brief Adds a key
+  /// @param key Key
+  inline void insert(std::uint64_t key) noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.increment(pos);
+  }
+
+  /// @brief Adds a batch of keys
+  /// @param keys Pointer to first key
+  /// @param count Number of keys
+  inline void insert(const std::uint64_t* keys, std::size_t count) noexcept {
+    this->for_each_probe(keys, count, [this](std::size_t pos) {
+      this->cells_.increment(pos);
+    });
+  }
+
+  /// @brief Thread-safe `insert()`
+  /// @param key Key
+  inline void insert_atomic(std::uint64_t key) noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.increment_atomic(pos);
+  }
+
+  /// @brief Removes a key that was inserted before
+  /// @param key Key
+  inline void erase(std::uint64_t key) noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.decrement(pos);
+  }
+
+  /// @brief Thread-safe `erase()`
+  /// @param key Key
+  inline void erase_atomic(std::uint64_t key) noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.decrement_atomic(pos);
+  }
+
+  /// @brief Estimates how often a key was inserted (never underestimates
+  /// below saturation)
+  /// @param key Key
+  /// @return Smallest counter among the key's probes
+  inline value_type count(std::uint64_t key) const noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    return this->cells_.template smallest<false>(positions, K);
+  }
+
+  /// @brief Thread-safe `count()` (may run alongside `*_atomic` writers)
+  /// @param key Key
+  /// @return Smallest counter among the key's probes
+  inline value_type count_atomic(std::uint64_t key) const noexcept {
+    std::size_t positions[K];
+    probes(key, positions);
+
+    return this->cells_.template smallest<true>(positions, K);
+  }
+
+  /// @brief Tests a key for membership (no false negatives)
+  /// @param key Key
+  /// @return `false` if the key was definitely not inserted
+  inline bool contains(std::uint64_t key) const noexcept {
+    return this->count(key) != 0;
+  }
+
+  /// @brief Thread-safe `contains()`
+  /// @param key Key
+  /// @return `false` if the key was definitely not inserted
+  inline bool contains_atomic(std::uint64_t key) const noexcept {
+    return this->count_atomic(key) != 0;
+  }
+
+  /// @brief Halves every counter (aging)
+  inline void halve() noexcept { this->cells_.halve(); }
+
+  /// @brief Thread-safe `halve()` (each word is halved atomically)
+  inline void halve_atomic() noexcept { this->cells_.halve_atomic(); }
+
+  /// @brief Removes all keys
+  inline void clear() noexcept { this->cells_.clear(); }
+
+  /// @brief Reads a counter
+  /// @param pos Counter index
+  /// @return Counter value
+  inline value_type cell(std::size_t pos) const noexcept {
+    return this->cells_.get(pos);
+  }
+};
+
+/// @brief Count-min sketch with W-bit saturating counters
+/// @tparam W Bit width of each counter (e.g. 4 or 8)
+/// @tparam Depth Number of rows (independent hashes)
+/// @tparam Width Number of counters per row
+///
+/// Rows are stored back to back in one packed array; a key's estimate is
+/// the smallest of its `Depth` counters.
+///
+/// While any thread calls a `*_atomic` member, every other thread must use
+/// `*_atomic` members too (`estimate_atomic()`, `halve_atomic()`).
+template <std::size_t W, std::size_t Depth, std::size_t Width>
+class count_min final {
+  static_assert(Depth != 0 && Depth <= 16, "Depth must be in [1, 16]");
+  static_assert(Width != 0, "Width must be non-zero");
+
+  using counters = impl::counter_array<W, Depth * Width>;
+
+  counters cells_{};
+
+  /// @brief Computes the counter of a key in every row
+  static inline void probes(std::uint64_t key, std::size_t* out) noexcept {
+    auto h1 = impl::mix64(key);
+    auto h2 = impl::mix64(h1) | 1;
+
+    for (std::size_t d = 0; d < Depth; ++d)
+      out[d] = d * Width + (std::size_t)((h1 + d * h2) % Width);
+  }
+
+ public:
+  /// @brief Counter type
+  using value_type = impl::fit_unsigned<W>;
+
+  /// @brief Largest value a counter can hold
+  static constexpr value_type counter_max = counters::counter_max;
+
+  /// @brief Number of rows
+  static constexpr std::size_t depth = Depth;
+
+  /// @brief Number of counters per row
+  static constexpr std::size_t width = Width;
+
+  /// @brief Counts one occurrence of a key
+  /// @param key Key
+  inline void increment(std::uint64_t key) noexcept {
+    std::size_t positions[Depth];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.increment(pos);
+  }
+
+  /// @brief Counts one occurrence of each key in a batch
+  /// @param keys Pointer to first key
+  /// @param count Number of keys
+  inline void increment(const std::uint64_t* keys,
+                        std::size_t count) noexcept {
+    std::size_t positions[impl::sketch_batch_size * Depth];
+
+    for (std::size_t base = 0; base < count;
+         base += impl::sketch_batch_size) {
+      auto n = count - base < impl::sketch_batch_size
+                   ? count - base
+                   : impl::sketch_batch_size;
+
+      for (std::size_t i = 0; i < n; ++i) {
+        probes(keys[base + i], &positions[i * Depth]);
+
+        for (std::size_t d = 0; d < Depth; ++d)
+          this->cells_.prefetch(positions[i * Depth + d]);
+      }
+
+      for (std::size_t i = 0; i < n * Depth; ++i)
+        this->cells_.increment(positions[i]);
+    }
+  }
+
+  /// @brief Thread-safe single-key `increment()`
+  /// @param key Key
+  inline void increment_atomic(std::uint64_t key) noexcept {
+    std::size_t positions[Depth];
+    probes(key, positions);
+
+    for (auto pos : positions) this->cells_.increment_atomic(pos);
+  }
+
+  /// @brief Estimates how often a key was counted (never underestimates
+  /// below saturation)
+  /// @param key Key
+  /// @return Smallest counter among the key's rows
+  inline value_type estimate(std::uint64_t key) const noexcept {
+    std::size_t positions[Depth];
+    probes(key, positions);
+
+    return this->cells_.template smallest<false>(positions, Depth);
+  }
+
+  /// @brief Thread-safe `estimate()` (may run alongside `*_atomic` writers)
+  /// @param key Key
+  /// @return Smallest counter among the key's rows
+  inline value_type estimate_atomic(std::uint64_t key) const noexcept {
+    std::size_t positions[Depth];
+    probes(key, positions);
+
+    return this->cells_.template smallest<true>(positions, Depth);
+  }
+
+  /// @brief Halves every counter (aging)
+  inline void halve() noexcept { this->cells_.halve(); }
+
+  /// @brief Thread-safe `halve()` (each word is halved atomically)
+  inline void halve_atomic() noexcept { this->cells_.halve_atomic(); }
+
+  /// @brief Resets every counter
+  inline void clear() noexcept { this->cells_.clear(); }
+
+  /// @brief Reads a counter
+  /// @param row Row index
+  /// @param column Counter index within the row
+  /// @return Counter value
+  inline value_type cell(std::size_t row, std::size_t column) const noexcept {
+    return this->cells_.get(row * Width + column);
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SKETCH_H_
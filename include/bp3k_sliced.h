@@ -0,0 +1,270 @@
+#ifndef _BITPACKER3000_SLICED_H_
+#define _BITPACKER3000_SLICED_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Comparison evaluated by `bitsliced_packer::scan()`
+enum class compare_op : std::uint8_t {
+  equal,
+  not_equal,
+  less,
+  less_equal,
+  greater,
+  greater_equal
+};
+
+/// @brief Bit-sliced (bit-transposed) array for fast predicate scans
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam N Packed-value capacity
+///
+/// Items are grouped in blocks of one word's width (64); block `b` stores W
+/// words, the k-th holding bit `W-1-k` of each of its items (item `j` at bit
+/// `j`). Comparing against a constant then costs a few bitwise operations per
+/// bit plane for a whole block and stops at the first plane after which no
+/// item still ties. Signed values are stored with the sign bit flipped so
+/// that unsigned order matches value order. Random access is slower than
+/// `bitpacker` (W words touched per item).
+template <typename T, std::size_t W, std::size_t N>
+class bitsliced_packer final {
+  static_assert(N != 0, "N must be non-zero");
+
+  using lane = impl::lane_dispatcher<T, W>;
+  using unsigned_type = typename lane::unsigned_type;
+
+  static constexpr std::size_t block_items = lane::word_width;
+  static constexpr std::size_t block_count_ =
+      (N + block_items - 1) / block_items;
+
+  /// @brief XOR-ed into stored codes so that unsigned order is value order
+  static constexpr std::uintmax_t order_flip =
+      lane::t_is_signed ? (std::uintmax_t)lane::sign_bit_mask : 0;
+
+  /// @brief Mask of the items that exist in the last block
+  static constexpr std::uintmax_t last_block_mask =
+      N % block_items ? ((std::uintmax_t)1 << (N % block_items)) - 1
+                      : ~(std::uintmax_t)0;
+
+  std::uintmax_t planes_[block_count_][W]{};
+
+  /// @brief Converts a value to its stored code
+  static inline constexpr std::uintmax_t code_of(T x) noexcept {
+    auto bits = (std::uintmax_t)((unsigned_type)x & lane::value_mask);
+    return bits ^ order_flip;
+  }
+
+  /// @brief Mask of the items that exist in a block
+  static inline constexpr std::uintmax_t block_mask(std::size_t b) noexcept {
+    return b == block_count_ - 1 ? last_block_mask : ~(std::uintmax_t)0;
+  }
+
+  /// @brief Checks if a constant is below `value_min`
+  static inline constexpr bool is_below(T c) noexcept {
+    if constexpr (lane::t_is_signed)
+      return (impl::impl_type<T>)c < (impl::impl_type<T>)value_min;
+    else
+      return false;
+  }
+
+  /// @brief Checks if a constant is above `value_max`
+  static inline constexpr bool is_above(T c) noexcept {
+    return (impl::impl_type<T>)c > (impl::impl_type<T>)value_max;
+  }
+
+  /// @brief Compares every item of a block with a constant
+  /// @param b Block index
+  /// @param c Constant
+  /// @param less Output mask of items below the constant
+  /// @param equal Output mask of items equal to the constant
+  inline constexpr void compare_block(std::size_t b, T c,
+                                      std::uintmax_t& less,
+                                      std::uintmax_t& equal) const noexcept {
+    const std::uintmax_t* planes = this->planes_[b];
+    auto code = code_of(c);
+
+    less = 0;
+    equal = 0;
+
+    // Constants outside [value_min, value_max] have no W-bit code
+    if (is_below(c)) return;
+
+    if (is_above(c)) {
+      less = block_mask(b);
+      return;
+    }
+
+    equal = block_mask(b);
+
+    for (std::size_t k = 0; k < W && equal != 0; ++k) {
+      auto bit = (code >> (W - 1 - k)) & 1;
+      auto plane = planes[k];
+
+      // Items still tying the constant diverge on the first differing bit
+      less |= equal & ~plane & (0 - bit);
+      equal &= bit ? plane : ~plane;
+    }
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of items per block (and bits per result word)
+  static constexpr std::size_t block_size = block_items;
+
+  /// @brief Number of blocks (and words in a scan result)
+  static constexpr std::size_t block_count = block_count_;
+
+  /// @brief Minimum value of T with width W
+  static constexpr T value_min = lane::value_min();
+
+  /// @brief Maximum value of T with width W
+  static constexpr T value_max = lane::value_max();
+
+  /// @brief Default constructor (all values zero)
+  bitsliced_packer() = default;
+
+  /// @brief Fill constructor
+  /// @param x Fill value
+  inline constexpr explicit bitsliced_packer(T x) noexcept { this->fill(x); }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline constexpr T at(std::size_t pos) const noexcept {
+    const std::uintmax_t* planes = this->planes_[pos / block_items];
+    auto bit = pos % block_items;
+    std::uintmax_t code = 0;
+
+    for (std::size_t k = 0; k < W; ++k)
+      code = (code << 1) | ((planes[k] >> bit) & 1);
+
+    code ^= order_flip;
+    return static_cast<T>(lane::extract_value(&code, 0));
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline constexpr T operator[](std::size_t pos) const noexcept {
+    return this->at(pos);
+  }
+
+  /// @brief Stores a value
+  /// @param pos Index of item
+  /// @param x Value (truncated to W bits)
+  inline constexpr void set(std::size_t pos, T x) noexcept {
+    std::uintmax_t* planes = this->planes_[pos / block_items];
+    auto bit = pos % block_items;
+    auto code = code_of(x);
+
+    for (std::size_t k = 0; k < W; ++k) {
+      auto b = (code >> (W - 1 - k)) & 1;
+      planes[k] = (planes[k] & ~((std::uintmax_t)1 << bit)) | (b << bit);
+    }
+  }
+
+  /// @brief Assigns `x` to all elements
+  /// @param x Fill value
+  inline constexpr void fill(T x) noexcept {
+    auto code = code_of(x);
+
+    for (std::size_t b = 0; b < block_count_; ++b) {
+      for (std::size_t k = 0; k < W; ++k) {
+        auto bit = (code >> (W - 1 - k)) & 1;
+        this->planes_[b][k] = (0 - bit) & block_mask(b);
+      }
+    }
+  }
+
+  /// @brief Marks items that compare true against a constant
+  /// @param op Comparison (`item op c`)
+  /// @param c Constant
+  /// @param out Pointer to `block_count` result words (bit `j` of word `b`
+  /// is item `b * block_size + j`); may be null to only count
+  /// @return Number of matching items
+  inline constexpr std::size_t scan(compare_op op, T c,
+                                    std::uintmax_t* out) const noexcept {
+    std::size_t matches = 0;
+
+    for (std::size_t b = 0; b < block_count_; ++b) {
+      std::uintmax_t less = 0, equal = 0;
+      auto all = block_mask(b);
+
+      this->compare_block(b, c, less, equal);
+
+      std::uintmax_t result = 0;
+
+      switch (op) {
+        case compare_op::equal:
+          result = equal;
+          break;
+        case compare_op::not_equal:
+          result = all & ~equal;
+          break;
+        case compare_op::less:
+          result = less;
+          break;
+        case compare_op::less_equal:
+          result = less | equal;
+          break;
+        case compare_op::greater:
+          result = all & ~(less | equal);
+          break;
+        case compare_op::greater_equal:
+          result = all & ~less;
+          break;
+      }
+
+      if (out != nullptr) out[b] = result;
+      matches += impl::popcount(result);
+    }
+
+    return matches;
+  }
+
+  /// @brief Marks items within a closed range
+  /// @param lo Lower bound (inclusive)
+  /// @param hi Upper bound (inclusive)
+  /// @param out Pointer to `block_count` result words; may be null
+  /// @return Number of matching items
+  inline constexpr std::size_t scan_between(
+      T lo, T hi, std::uintmax_t* out) const noexcept {
+    std::size_t matches = 0;
+
+    for (std::size_t b = 0; b < block_count_; ++b) {
+      std::uintmax_t lo_less = 0, lo_equal = 0, hi_less = 0, hi_equal = 0;
+
+      this->compare_block(b, lo, lo_less, lo_equal);
+      this->compare_block(b, hi, hi_less, hi_equal);
+
+      auto result = block_mask(b) & ~lo_less & (hi_less | hi_equal);
+
+      if (out != nullptr) out[b] = result;
+      matches += impl::popcount(result);
+    }
+
+    return matches;
+  }
+
+  /// @brief Fetches the bit planes of a block
+  /// @param b Block index
+  /// @return Pointer to W words (most significant plane first)
+  inline constexpr const std::uintmax_t* planes(std::size_t b) const noexcept {
+    return this->planes_[b];
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return N
+  inline constexpr std::size_t size() const noexcept { return N; }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SLICED_H_
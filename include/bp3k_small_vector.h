@@ -0,0 +1,340 @@
+#ifndef _BITPACKER3000_SMALL_VECTOR_H_
+#define _BITPACKER3000_SMALL_VECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Growable packed vector with inline storage for its first K words
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam K Number of inline words
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// Words use the `bitpacker` layout. Up to `inline_capacity` items live in
+/// the object itself; growing past that moves every word to the heap (or
+/// to the memory resource given at construction), doubling on each spill.
+/// Items past `size()` are kept zero.
+template <typename T, std::size_t W, std::size_t K,
+          typename E = twos_complement>
+class small_packed_vector final {
+  static_assert(K != 0, "K must be non-zero");
+
+  using lane = impl::lane_dispatcher<T, W, E>;
+  using unsigned_type = typename lane::unsigned_type;
+
+ public:
+  /// @brief Proxy object that provides reference to packed item
+  using item_proxy = bp3k::item_proxy<T, W, E>;
+
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Storage type
+  using word_type = std::uintmax_t;
+
+  /// @brief Storage policy
+  using encoding_type = E;
+
+  /// @brief small_packed_vector<T, W, K>::item_proxy
+  using reference = item_proxy;
+
+  /// @brief const small_packed_vector<T, W, K>::item_proxy
+  using const_reference = const item_proxy;
+
+  /// @brief Minimum value of T with width W
+  static constexpr T value_min = lane::value_min();
+
+  /// @brief Maximum value of T with width W
+  static constexpr T value_max = lane::value_max();
+
+  /// @brief Number of items that fit without a heap allocation
+  static constexpr std::size_t inline_capacity = K * lane::per_word;
+
+ private:
+  std::uintmax_t inline_[K]{};
+  impl::word_buffer heap_{};
+  std::size_t size_{};
+
+  /// @brief Checks if the items live in `heap_`
+  inline bool spilled() const noexcept { return this->heap_.data() != nullptr; }
+
+  /// @brief Returns the number of words currently available
+  inline std::size_t word_capacity() const noexcept {
+    return this->spilled() ? this->heap_.capacity() : K;
+  }
+
+  /// @brief Zeroes the items in `[first, last)`
+  inline void clear_items(std::size_t first, std::size_t last) noexcept {
+    auto words = this->data();
+
+    for (; first < last && lane::item_offset(first) != lane::front_offset;
+         ++first)
+      lane::embed_value(&words[lane::word_index(first)],
+                        lane::item_offset(first), 0);
+
+    for (; first + lane::per_word <= last; first += lane::per_word)
+      words[lane::word_index(first)] = 0;
+
+    for (; first < last; ++first)
+      lane::embed_value(&words[lane::word_index(first)],
+                        lane::item_offset(first), 0);
+  }
+
+ public:
+  /// @brief Default constructor (empty, inline)
+  small_packed_vector() = default;
+
+  /// @brief Constructor (empty, inline)
+  /// @param resource Source of spilled storage (null for the global heap)
+  inline explicit small_packed_vector(
+      std::pmr::memory_resource* resource) noexcept
+      : heap_(resource) {}
+
+  small_packed_vector(const small_packed_vector&) = delete;
+  small_packed_vector& operator=(const small_packed_vector&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Vector to take ownership from
+  inline small_packed_vector(small_packed_vector&& other) noexcept {
+    this->swap(other);
+  }
+
+  /// @brief Move assignment
+  /// @param other Vector to take ownership from
+  /// @return Self reference
+  inline small_packed_vector& operator=(small_packed_vector&& other) noexcept {
+    small_packed_vector tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents of the container with those of `other`
+  /// @param other Vector to swap with
+  inline void swap(small_packed_vector& other) noexcept {
+    for (std::size_t i = 0; i < K; ++i)
+      std::swap(this->inline_[i], other.inline_[i]);
+
+    this->heap_.swap(other.heap_);
+    std::swap(this->size_, other.size_);
+  }
+
+  /// @brief Fetches reference to packed item
+  /// @param pos Index of item
+  /// @return Reference to packed item
+  inline reference at(std::size_t pos) noexcept {
+    return impl::proxy_access::make<T, W, E>(
+        &this->data()[lane::word_index(pos)], lane::item_offset(pos));
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T at(std::size_t pos) const noexcept {
+    return static_cast<T>(lane::extract_value(
+        &this->data()[lane::word_index(pos)], lane::item_offset(pos)));
+  }
+
+  /// @brief Fetches reference to packed item
+  /// @param pos Index of item
+  /// @return Reference to packed item
+  inline reference operator[](std::size_t pos) noexcept {
+    return this->at(pos);
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Extracted value
+  inline T operator[](std::size_t pos) const noexcept { return this->at(pos); }
+
+  /// @brief Fetches reference to first item
+  /// @return Reference to first item
+  inline reference front() noexcept { return this->at(0); }
+
+  /// @brief Fetches value of first item
+  /// @return Value of first item
+  inline T front() const noexcept { return this->at(0); }
+
+  /// @brief Fetches reference to last item
+  /// @return Reference to last item
+  inline reference back() noexcept { return this->at(this->size_ - 1); }
+
+  /// @brief Fetches value of last item
+  /// @return Value of last item
+  inline T back() const noexcept { return this->at(this->size_ - 1); }
+
+  /// @brief Decodes consecutive items
+  /// @param pos Index of first item
+  /// @param count Number of items
+  /// @param out Output values
+  inline void unpack(std::size_t pos, std::size_t count,
+                     T* out) const noexcept {
+    lane::unpack(this->data(), pos, count, out);
+  }
+
+  /// @brief Visits all items in order
+  /// @tparam F Callable as `f(T)`
+  /// @param f Visitor
+  template <typename F>
+  inline void for_each(F&& f) const {
+    lane::for_each(this->data(), 0, this->size_, f);
+  }
+
+  /// @brief Reads a batch of items at arbitrary indices
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param out Output values (`out[i]` is item `indices[i]`)
+  inline void gather(const std::size_t* indices, std::size_t count,
+                     T* out) const noexcept {
+    lane::gather(this->data(), indices, count, out);
+  }
+
+  /// @brief Writes a batch of items at arbitrary indices
+  /// @param indices Item indices
+  /// @param count Number of indices
+  /// @param values Input values (`values[i]` goes to item `indices[i]`)
+  inline void scatter(const std::size_t* indices, std::size_t count,
+                      const T* values) noexcept {
+    lane::scatter(this->data(), indices, count, values);
+  }
+
+  /// @brief Fetches address of word storage
+  /// @return Pointer to first word
+  inline std::uintmax_t* data() noexcept {
+    return this->spilled() ? this->heap_.data() : this->inline_;
+  }
+
+  /// @brief Fetches address of word storage
+  /// @return Const pointer to first word
+  inline const std::uintmax_t* data() const noexcept {
+    return this->spilled() ? this->heap_.data() : this->inline_;
+  }
+
+  /// @brief Checks if the container has no elements
+  /// @return `true` if the container is empty, `false` otherwise
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of elements in the container
+  /// @return Element count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Returns the number of elements that fit without reallocation
+  /// @return Element capacity
+  inline std::size_t capacity() const noexcept {
+    return this->word_capacity() * lane::per_word;
+  }
+
+  /// @brief Checks if the items are still stored inline
+  /// @return `true` if no heap storage is in use
+  inline bool is_inline() const noexcept { return !this->spilled(); }
+
+  /// @brief Returns the number of words in use
+  /// @return Word count
+  inline std::size_t word_count() const noexcept {
+    return lane::words_for(this->size_);
+  }
+
+  /// @brief Grows storage to hold at least `count` items
+  /// @param count Requested capacity
+  /// @return `false` if allocation failed (the vector is left untouched)
+  inline bool reserve(std::size_t count) noexcept {
+    auto words = lane::words_for(count);
+    auto current = this->word_capacity();
+
+    if (words <= current) return true;
+    if (words < current * 2) words = current * 2;
+
+    impl::word_buffer grown(this->heap_.resource());
+
+    if (!grown.allocate(words)) return false;
+
+    const std::uintmax_t* source = this->data();
+
+    for (std::size_t i = 0; i < this->word_count(); ++i)
+      grown.data()[i] = source[i];
+
+    this->heap_.swap(grown);
+    return true;
+  }
+
+  /// @brief Changes the number of items (new items are zero)
+  /// @param count New item count
+  /// @return `false` if allocation failed (the vector is left untouched)
+  inline bool resize(std::size_t count) noexcept {
+    if (!this->reserve(count)) return false;
+
+    if (count < this->size_) this->clear_items(count, this->size_);
+
+    this->size_ = count;
+    return true;
+  }
+
+  /// @brief Appends an item
+  /// @param x Value
+  /// @return `false` if allocation failed (the vector is left untouched)
+  inline bool push_back(T x) noexcept {
+    if (!this->reserve(this->size_ + 1)) return false;
+
+    this->at(this->size_++) = x;
+    return true;
+  }
+
+  /// @brief Removes the last item (no-op when empty)
+  inline void pop_back() noexcept {
+    if (this->size_ == 0) return;
+
+    --this->size_;
+    this->clear_items(this->size_, this->size_ + 1);
+  }
+
+  /// @brief Removes all items (capacity is retained)
+  inline void clear() noexcept { this->resize(0); }
+
+  /// @brief Assigns `x` to all elements in the container
+  /// @param x The value to assign
+  inline void fill(T x) noexcept {
+    if (this->size_ == 0) return;
+
+    auto rest = this->size_ % lane::per_word;
+
+    lane::fill_words(this->data(), this->word_count(),
+                     rest != 0 ? rest : lane::per_word, (unsigned_type)x);
+  }
+
+  /// @brief Returns the source of spilled storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->heap_.resource();
+  }
+};
+
+/// @brief Compares the items of two vectors
+/// @return `true` if both hold the same items
+template <typename T, std::size_t W, std::size_t K, std::size_t K2,
+          typename E>
+inline bool operator==(const small_packed_vector<T, W, K, E>& lhs,
+                       const small_packed_vector<T, W, K2, E>& rhs) noexcept {
+  if (lhs.size() != rhs.size()) return false;
+
+  // Items past size() are zero, so whole words compare equal
+  return impl::compare_words(lhs.data(), rhs.data(), lhs.word_count()) == 0;
+}
+
+/// @brief Compares the items of two vectors
+/// @return `true` if the vectors differ
+template <typename T, std::size_t W, std::size_t K, std::size_t K2,
+          typename E>
+inline bool operator!=(const small_packed_vector<T, W, K, E>& lhs,
+                       const small_packed_vector<T, W, K2, E>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SMALL_VECTOR_H_
@@ -0,0 +1,325 @@
+#ifndef _BITPACKER3000_SPARSE_H_
+#define _BITPACKER3000_SPARSE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k::impl {
+
+/// @brief Number of items covered by one `sparse_packer` rank counter
+inline constexpr std::size_t sparse_rank_items =
+    8 * (sizeof(std::uintmax_t) << 3);
+
+/// @brief Rank index and memory resource of a large `sparse_packer`
+/// @tparam N Packed-value capacity
+/// @tparam Ranked Whether N spans more than one rank counter
+template <std::size_t N, bool Ranked = (N > sparse_rank_items)>
+struct sparse_extras {
+  /// @brief Rank counter type
+  using rank_type =
+      typename std::conditional<(N <= 0xffffffffu), std::uint32_t,
+                                std::size_t>::type;
+
+  /// @brief Exception count before each span of `sparse_rank_items` items
+  rank_type ranks_[(N + sparse_rank_items - 1) / sparse_rank_items]{};
+  /// @brief Source of exception storage (null for the global heap)
+  std::pmr::memory_resource* resource_{};
+};
+
+/// @brief Small packers popcount their whole bitmap and use the global heap
+/// @tparam N Packed-value capacity
+template <std::size_t N>
+struct sparse_extras<N, false> {};
+
+}  // namespace bp3k::impl
+
+namespace bp3k {
+
+/// @brief Compressed, read-only form of a mostly-constant `bitpacker`
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam N Packed-value capacity
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// A bitmap marks items that differ from a default value; only those are
+/// packed (in order) on the heap. A rank index (one counter per 512 items)
+/// turns a position into its exception index with at most 8 popcounts, so
+/// `at()` is O(1). Convert back with `expand()` to modify.
+///
+/// Up to 512 items there is a single rank span, so the index is left out
+/// together with the memory resource pointer: such a packer holds only the
+/// bitmap, an exception pointer, a count and the default value, and
+/// exceptions come from the global heap.
+template <typename T, std::size_t W, std::size_t N,
+          typename E = twos_complement>
+class sparse_packer final : impl::sparse_extras<N> {
+  static_assert(N != 0, "N must be non-zero");
+
+  using lane = impl::lane_dispatcher<T, W, E>;
+  using unsigned_type = typename lane::unsigned_type;
+  using rank_type = typename impl::sparse_extras<N, true>::rank_type;
+
+  static constexpr std::size_t word_width = lane::word_width;
+  static constexpr std::size_t bitmap_words =
+      (N + word_width - 1) / word_width;
+  static constexpr std::size_t rank_span = 8;
+  static constexpr std::size_t rank_items = impl::sparse_rank_items;
+  static constexpr bool ranked = N > rank_items;
+
+  std::uintmax_t bitmap_[bitmap_words]{};
+  std::uintmax_t* exceptions_{};
+  rank_type exception_count_{};
+  T default_{};
+
+  /// @brief Obtains zeroed storage for `count` words
+  /// @return Pointer to storage, or null if allocation failed
+  inline std::uintmax_t* allocate_words(std::size_t count) const noexcept {
+    auto resource = this->resource();
+
+    if (resource == nullptr) return new (std::nothrow) std::uintmax_t[count]();
+
+    void* bytes = nullptr;
+
+#if defined(__cpp_exceptions)
+    try {
+      bytes = resource->allocate(count * sizeof(std::uintmax_t),
+                                 alignof(std::uintmax_t));
+    } catch (...) {
+      return nullptr;
+    }
+#else
+    bytes = resource->allocate(count * sizeof(std::uintmax_t),
+                               alignof(std::uintmax_t));
+#endif
+
+    if (bytes == nullptr) return nullptr;
+
+    auto words = static_cast<std::uintmax_t*>(bytes);
+
+    for (std::size_t i = 0; i < count; ++i) words[i] = 0;
+
+    return words;
+  }
+
+  /// @brief Returns the exception words to where they came from
+  inline void release_words() noexcept {
+    auto resource = this->resource();
+
+    if (resource == nullptr) {
+      delete[] this->exceptions_;
+    } else if (this->exceptions_ != nullptr) {
+      resource->deallocate(
+          this->exceptions_,
+          lane::words_for(this->exception_count_) * sizeof(std::uintmax_t),
+          alignof(std::uintmax_t));
+    }
+
+    this->exceptions_ = nullptr;
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Uncompressed counterpart
+  using packer_type = bitpacker<T, W, N, E>;
+
+  /// @brief Constructor (every item is `default_value`)
+  /// @param default_value Value of unmarked items
+  inline explicit sparse_packer(T default_value = T{}) noexcept
+      : default_(default_value) {}
+
+  /// @brief Constructor (every item is `default_value`, more than 512 items)
+  /// @param default_value Value of unmarked items
+  /// @param resource Source of exception storage (null for the global heap)
+  template <bool R = ranked, typename = typename std::enable_if<R>::type>
+  inline sparse_packer(T default_value,
+                       std::pmr::memory_resource* resource) noexcept
+      : default_(default_value) {
+    this->resource_ = resource;
+  }
+
+  /// @brief Destructor
+  inline ~sparse_packer() noexcept { this->release_words(); }
+
+  sparse_packer(const sparse_packer&) = delete;
+  sparse_packer& operator=(const sparse_packer&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Packer to take ownership from
+  inline sparse_packer(sparse_packer&& other) noexcept { this->swap(other); }
+
+  /// @brief Move assignment
+  /// @param other Packer to take ownership from
+  /// @return Self reference
+  inline sparse_packer& operator=(sparse_packer&& other) noexcept {
+    sparse_packer tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+
+  /// @brief Exchanges the contents of the container with those of `other`
+  /// @param other Packer to swap with
+  inline void swap(sparse_packer& other) noexcept {
+    for (std::size_t i = 0; i < bitmap_words; ++i)
+      std::swap(this->bitmap_[i], other.bitmap_[i]);
+
+    if constexpr (ranked) {
+      for (std::size_t i = 0; i < (N + rank_items - 1) / rank_items; ++i)
+        std::swap(this->ranks_[i], other.ranks_[i]);
+
+      std::swap(this->resource_, other.resource_);
+    }
+
+    std::swap(this->exceptions_, other.exceptions_);
+    std::swap(this->exception_count_, other.exception_count_);
+    std::swap(this->default_, other.default_);
+  }
+
+  /// @brief Compresses a `bitpacker`, replacing the current contents
+  /// @param bp Source
+  /// @param default_value Value left out of the exception list
+  /// @return `false` if allocation failed (contents are left untouched)
+  inline bool compress(const packer_type& bp, T default_value) noexcept {
+    std::size_t count = 0;
+
+    bp.for_each([&](T x) { count += (std::size_t)(x != default_value); });
+
+    std::uintmax_t* words = nullptr;
+
+    if (count != 0 &&
+        (words = this->allocate_words(lane::words_for(count))) == nullptr)
+      return false;
+
+    std::size_t pos = 0, k = 0;
+
+    for (auto& word : this->bitmap_) word = 0;
+
+    bp.for_each([&](T x) {
+      if (x != default_value) {
+        this->bitmap_[pos / word_width] |= (std::uintmax_t)1
+                                           << (pos % word_width);
+        lane::embed_value(&words[lane::word_index(k)], lane::item_offset(k),
+                          static_cast<unsigned_type>(x));
+        ++k;
+      }
+
+      ++pos;
+    });
+
+    if constexpr (ranked) {
+      std::size_t rank = 0;
+
+      for (std::size_t i = 0; i < bitmap_words; ++i) {
+        if (i % rank_span == 0) this->ranks_[i / rank_span] = (rank_type)rank;
+
+        rank += impl::popcount(this->bitmap_[i]);
+      }
+    }
+
+    this->release_words();
+    this->exceptions_ = words;
+    this->exception_count_ = (rank_type)count;
+    this->default_ = default_value;
+    return true;
+  }
+
+  /// @brief Compresses a `bitpacker` around its first item's value
+  /// @param bp Source
+  /// @return `false` if allocation failed (contents are left untouched)
+  inline bool compress(const packer_type& bp) noexcept {
+    return this->compress(bp, bp.front());
+  }
+
+  /// @brief Decompresses into a `bitpacker`
+  /// @param bp Destination (every item is overwritten)
+  inline void expand(packer_type& bp) const noexcept {
+    const std::uintmax_t* words = this->exceptions_;
+    std::size_t k = 0;
+
+    bp.fill(this->default_);
+
+    for (std::size_t i = 0; i < bitmap_words; ++i) {
+      // Visit set bits only
+      for (auto bits = this->bitmap_[i]; bits != 0; bits &= bits - 1) {
+        auto pos = i * word_width + (impl::popcount((bits & (0 - bits)) - 1));
+        bp[pos] = static_cast<T>(lane::extract_value(
+            &words[lane::word_index(k)], lane::item_offset(k)));
+        ++k;
+      }
+    }
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T at(std::size_t pos) const noexcept {
+    auto i = pos / word_width;
+    auto bit = pos % word_width;
+    auto word = this->bitmap_[i];
+
+    if (!((word >> bit) & 1)) return this->default_;
+
+    std::size_t k = 0, j = 0;
+
+    if constexpr (ranked) {
+      k = this->ranks_[i / rank_span];
+      j = i - i % rank_span;
+    }
+
+    for (; j < i; ++j)
+      k += impl::popcount(this->bitmap_[j]);
+
+    k += impl::popcount(word & (((std::uintmax_t)1 << bit) - 1));
+
+    return static_cast<T>(lane::extract_value(
+        &this->exceptions_[lane::word_index(k)], lane::item_offset(k)));
+  }
+
+  /// @brief Fetches value of packed item
+  /// @param pos Index of item
+  /// @return Decoded value
+  inline T operator[](std::size_t pos) const noexcept { return this->at(pos); }
+
+  /// @brief Returns the value of unmarked items
+  /// @return Default value
+  inline T default_value() const noexcept { return this->default_; }
+
+  /// @brief Returns the number of items that differ from the default
+  /// @return Exception count
+  inline std::size_t exception_count() const noexcept {
+    return this->exception_count_;
+  }
+
+  /// @brief Returns the number of elements in the container
+  /// @return N
+  inline constexpr std::size_t size() const noexcept { return N; }
+
+  /// @brief Returns the storage footprint (inline and heap)
+  /// @return Byte count
+  inline std::size_t bytes_used() const noexcept {
+    return sizeof(sparse_packer) +
+           lane::words_for(this->exception_count_) * sizeof(std::uintmax_t);
+  }
+
+  /// @brief Returns the source of exception storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    if constexpr (ranked) {
+      return this->resource_;
+    } else {
+      return nullptr;
+    }
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_SPARSE_H_
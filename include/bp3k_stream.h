@@ -0,0 +1,199 @@
+#ifndef _BITPACKER3000_STREAM_H_
+#define _BITPACKER3000_STREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "bp3k.h"
+
+namespace bp3k {
+
+/// @brief Streaming encoder that emits fixed-size chunks of packed words
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam Sink Callable as `sink(const std::uintmax_t* words,
+/// std::size_t item_count)`
+/// @tparam ChunkWords Number of words per chunk
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+///
+/// Chunks use the `bitpacker` layout and hold `chunk_items` values; only the
+/// chunk emitted by `flush()` may hold fewer. The chunk buffer is inline, so
+/// the writer never allocates.
+template <typename T, std::size_t W, typename Sink,
+          std::size_t ChunkWords = 1024, typename E = twos_complement>
+class packed_writer final {
+  static_assert(ChunkWords != 0, "ChunkWords must be non-zero");
+
+  using lane = impl::lane_dispatcher<T, W, E>;
+  using unsigned_type = typename lane::unsigned_type;
+
+  std::uintmax_t chunk_[ChunkWords]{};
+  /// @brief Word being filled
+  std::uintmax_t word_{};
+  /// @brief Offset of the next item in `word_`
+  std::size_t offset_{lane::front_offset};
+  /// @brief Number of complete words in `chunk_`
+  std::size_t word_pos_{};
+  /// @brief Number of values pushed so far
+  std::size_t size_{};
+  Sink sink_;
+
+  /// @brief Converts a value to its lane bits
+  static inline constexpr std::uintmax_t lane_bits(T x) noexcept {
+    auto bits = lane::encode_value(static_cast<unsigned_type>(x));
+    return (std::uintmax_t)(bits & lane::value_mask);
+  }
+
+  /// @brief Stores the current word and emits the chunk once it is full
+  inline void commit_word() {
+    this->chunk_[this->word_pos_++] = this->word_;
+    this->word_ = 0;
+    this->offset_ = lane::front_offset;
+
+    if (this->word_pos_ == ChunkWords) {
+      this->sink_(static_cast<const std::uintmax_t*>(this->chunk_),
+                  chunk_items);
+      this->word_pos_ = 0;
+    }
+  }
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Number of values in a full chunk
+  static constexpr std::size_t chunk_items = ChunkWords * lane::per_word;
+
+  /// @brief Constructor
+  /// @param sink Chunk consumer
+  inline explicit packed_writer(Sink sink) : sink_(std::move(sink)) {}
+
+  packed_writer(const packed_writer&) = delete;
+  packed_writer& operator=(const packed_writer&) = delete;
+
+  /// @brief Destructor (emits any buffered values)
+  inline ~packed_writer() { this->flush(); }
+
+  /// @brief Appends a value
+  /// @param x Value
+  inline void push(T x) {
+    this->word_ |= lane_bits(x) << this->offset_;
+    ++this->size_;
+
+    if (this->offset_ < W)
+      this->commit_word();
+    else
+      this->offset_ -= W;
+  }
+
+  /// @brief Appends a batch of values
+  /// @param values Pointer to first value
+  /// @param count Number of values
+  inline void push(const T* values, std::size_t count) {
+    // Top up the partially filled word first
+    while (count != 0 && this->offset_ != lane::front_offset) {
+      this->push(*values++);
+      --count;
+    }
+
+    // Whole words: no per-value bookkeeping
+    for (; count >= lane::per_word; count -= lane::per_word) {
+      std::uintmax_t word{};
+      auto offset = lane::front_offset;
+
+      for (std::size_t i = 0; i < lane::per_word; ++i, offset -= W)
+        word |= lane_bits(values[i]) << offset;
+
+      values += lane::per_word;
+      this->size_ += lane::per_word;
+      this->word_ = word;
+      this->commit_word();
+    }
+
+    while (count-- != 0) this->push(*values++);
+  }
+
+  /// @brief Emits buffered values as a (possibly partial) chunk
+  inline void flush() {
+    auto partial = (lane::front_offset - this->offset_) / W;
+    auto items = this->word_pos_ * lane::per_word + partial;
+
+    if (items == 0) return;
+
+    if (partial != 0) this->chunk_[this->word_pos_] = this->word_;
+
+    this->sink_(static_cast<const std::uintmax_t*>(this->chunk_), items);
+    this->word_ = 0;
+    this->offset_ = lane::front_offset;
+    this->word_pos_ = 0;
+  }
+
+  /// @brief Returns the number of values pushed so far
+  /// @return Value count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Fetches the sink
+  /// @return Reference to the sink
+  inline Sink& sink() noexcept { return this->sink_; }
+};
+
+/// @brief Lazy decoder for chunks produced by `packed_writer`
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+/// @tparam E Storage policy (`twos_complement` or `zigzag`)
+template <typename T, std::size_t W, typename E = twos_complement>
+class packed_reader final {
+  using lane = impl::lane_dispatcher<T, W, E>;
+
+  const std::uintmax_t* words_{};
+  std::size_t size_{};
+  std::size_t pos_{};
+
+ public:
+  /// @brief T
+  using value_type = T;
+
+  /// @brief Default constructor (no chunk)
+  packed_reader() = default;
+
+  /// @brief Constructor
+  /// @param words Pointer to first word of a chunk
+  /// @param item_count Number of values in the chunk
+  inline constexpr packed_reader(const std::uintmax_t* words,
+                                 std::size_t item_count) noexcept
+      : words_(words), size_(item_count) {}
+
+  /// @brief Starts reading another chunk
+  /// @param words Pointer to first word of a chunk
+  /// @param item_count Number of values in the chunk
+  inline constexpr void reset(const std::uintmax_t* words,
+                              std::size_t item_count) noexcept {
+    this->words_ = words;
+    this->size_ = item_count;
+    this->pos_ = 0;
+  }
+
+  /// @brief Decodes the next values of the chunk
+  /// @param out Output buffer
+  /// @param max_count Capacity of `out`
+  /// @return Number of values written (0 once the chunk is exhausted)
+  inline constexpr std::size_t read(T* out, std::size_t max_count) noexcept {
+    auto remaining = this->size_ - this->pos_;
+    auto count = max_count < remaining ? max_count : remaining;
+
+    lane::unpack(this->words_, this->pos_, count, out);
+    this->pos_ += count;
+    return count;
+  }
+
+  /// @brief Returns the number of values not read yet
+  /// @return Remaining value count
+  inline constexpr std::size_t remaining() const noexcept {
+    return this->size_ - this->pos_;
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_STREAM_H_
@@ -0,0 +1,349 @@
+#ifndef _BITPACKER3000_TABLE_H_
+#define _BITPACKER3000_TABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <utility>
+
+#include "bp3k.h"
+#include "bp3k_detail.h"
+
+namespace bp3k {
+
+/// @brief Column descriptor for `packed_table`
+/// @tparam T I/O value type (signed/unsigned integral or enumeration type)
+/// @tparam W Bit width of packed values
+template <typename T, std::size_t W>
+struct column final {
+  /// @brief T
+  using value_type = T;
+
+  /// @brief W
+  static constexpr std::size_t width = W;
+};
+
+/// @brief Columnar (struct-of-arrays) table of bit-packed columns
+/// @tparam Columns `column<T, W>` descriptors, one per column
+///
+/// Each column is stored as its own contiguous word array in the `bitpacker`
+/// layout; row count and capacity are shared by all columns.
+template <typename... Columns>
+class packed_table final {
+  static_assert(sizeof...(Columns) > 0, "packed_table needs a column");
+
+  static constexpr std::size_t column_count_ = sizeof...(Columns);
+
+  template <typename C>
+  using lane_of = impl::lane_dispatcher<typename C::value_type, C::width>;
+
+  /// @brief Items per word of each column
+  static constexpr std::array<std::size_t, column_count_> per_word_ = {
+      lane_of<Columns>::per_word...};
+
+  std::array<impl::word_buffer, column_count_> columns_{};
+  std::size_t size_{};
+  std::size_t capacity_{};
+
+ public:
+  /// @brief Descriptor of the I-th column
+  template <std::size_t I>
+  using column_type = std::tuple_element_t<I, std::tuple<Columns...>>;
+
+  /// @brief I/O value type of the I-th column
+  template <std::size_t I>
+  using column_value_type = typename column_type<I>::value_type;
+
+  /// @brief Tuple of references to the items of one row
+  using reference =
+      std::tuple<item_proxy<typename Columns::value_type, Columns::width>...>;
+
+  /// @brief Tuple of the values of one row
+  using value_type = std::tuple<typename Columns::value_type...>;
+
+ private:
+  template <std::size_t I>
+  using lane_at = lane_of<column_type<I>>;
+
+  /// @brief Zeroes the items of one column in `[first, last)`
+  template <std::size_t I>
+  inline void clear_rows(std::size_t first, std::size_t last) noexcept {
+    using lane = lane_at<I>;
+    auto words = this->columns_[I].data();
+
+    for (; first < last && lane::item_offset(first) != lane::front_offset;
+         ++first)
+      lane::embed_value(&words[lane::word_index(first)],
+                        lane::item_offset(first), 0);
+
+    for (; first + lane::per_word <= last; first += lane::per_word)
+      words[lane::word_index(first)] = 0;
+
+    for (; first < last; ++first)
+      lane::embed_value(&words[lane::word_index(first)],
+                        lane::item_offset(first), 0);
+  }
+
+  template <std::size_t... Is>
+  inline void clear_rows(std::size_t first, std::size_t last,
+                         std::index_sequence<Is...>) noexcept {
+    (this->clear_rows<Is>(first, last), ...);
+  }
+
+  template <std::size_t... Is>
+  inline void embed_row(std::size_t pos, const value_type& values,
+                        std::index_sequence<Is...>) noexcept {
+    ((this->at<Is>(pos) = std::get<Is>(values)), ...);
+  }
+
+  template <std::size_t... Is>
+  inline reference row(std::size_t pos, std::index_sequence<Is...>) noexcept {
+    return reference(this->at<Is>(pos)...);
+  }
+
+  template <std::size_t... Is>
+  inline value_type row(std::size_t pos,
+                        std::index_sequence<Is...>) const noexcept {
+    return value_type(this->at<Is>(pos)...);
+  }
+
+ public:
+  /// @brief Default constructor (no allocation)
+  packed_table() = default;
+
+  /// @brief Constructor (no allocation)
+  /// @param resource Source of column storage (null for the global heap)
+  inline explicit packed_table(std::pmr::memory_resource* resource) noexcept {
+    for (auto& column : this->columns_) column = impl::word_buffer(resource);
+  }
+
+  packed_table(const packed_table&) = delete;
+  packed_table& operator=(const packed_table&) = delete;
+
+  /// @brief Move constructor
+  /// @param other Table to take ownership from
+  inline packed_table(packed_table&& other) noexcept
+      : columns_(std::move(other.columns_)),
+        size_(other.size_),
+        capacity_(other.capacity_) {
+    other.size_ = 0;
+    other.capacity_ = 0;
+  }
+
+  /// @brief Move assignment
+  /// @param other Table to take ownership from
+  /// @return Self reference
+  inline packed_table& operator=(packed_table&& other) noexcept {
+    if (this != &other) {
+      this->columns_ = std::move(other.columns_);
+      this->size_ = other.size_;
+      this->capacity_ = other.capacity_;
+      other.size_ = 0;
+      other.capacity_ = 0;
+    }
+
+    return *this;
+  }
+
+  /// @brief Returns the number of columns
+  /// @return `sizeof...(Columns)`
+  static inline constexpr std::size_t column_count() noexcept {
+    return column_count_;
+  }
+
+  /// @brief Checks if the table has no rows
+  /// @return `true` if the table is empty, `false` otherwise
+  inline bool empty() const noexcept { return this->size_ == 0; }
+
+  /// @brief Returns the number of rows
+  /// @return Row count
+  inline std::size_t size() const noexcept { return this->size_; }
+
+  /// @brief Returns the number of rows that fit without reallocation
+  /// @return Row capacity
+  inline std::size_t capacity() const noexcept { return this->capacity_; }
+
+  /// @brief Returns the source of column storage
+  /// @return Memory resource (null for the global heap)
+  inline std::pmr::memory_resource* resource() const noexcept {
+    return this->columns_[0].resource();
+  }
+
+  /// @brief Grows every column to hold at least `rows` rows
+  /// @param rows Requested row capacity
+  /// @return `false` if allocation failed (the table is left untouched)
+  inline bool reserve(std::size_t rows) noexcept {
+    if (rows <= this->capacity_) return true;
+
+    std::array<impl::word_buffer, column_count_> grown{};
+
+    for (std::size_t i = 0; i < column_count_; ++i) {
+      auto words = (rows + per_word_[i] - 1) / per_word_[i];
+
+      grown[i] = impl::word_buffer(this->columns_[i].resource());
+      if (!grown[i].allocate(words)) return false;
+    }
+
+    for (std::size_t i = 0; i < column_count_; ++i) {
+      grown[i].copy_from(this->columns_[i], this->columns_[i].capacity());
+      grown[i].swap(this->columns_[i]);
+    }
+
+    this->capacity_ = rows;
+    return true;
+  }
+
+  /// @brief Changes the number of rows (new rows are zero-initialized)
+  /// @param rows New row count
+  /// @return `false` if allocation failed (the table is left untouched)
+  inline bool resize(std::size_t rows) noexcept {
+    if (!this->reserve(rows)) return false;
+
+    if (rows < this->size_)
+      this->clear_rows(rows, this->size_,
+                       std::make_index_sequence<column_count_>{});
+
+    this->size_ = rows;
+    return true;
+  }
+
+  /// @brief Removes all rows (capacity is retained)
+  inline void clear() noexcept { this->resize(0); }
+
+  /// @brief Appends a row
+  /// @param values One value per column
+  /// @return `false` if allocation failed (the table is left untouched)
+  inline bool push_back(typename Columns::value_type... values) noexcept {
+    if (this->size_ == this->capacity_) {
+      auto rows = this->capacity_ < 8 ? 8 : this->capacity_ * 2;
+      if (!this->reserve(rows)) return false;
+    }
+
+    this->embed_row(this->size_++, value_type(values...),
+                    std::make_index_sequence<column_count_>{});
+    return true;
+  }
+
+  /// @brief Removes the last row
+  inline void pop_back() noexcept {
+    if (this->size_ != 0) this->resize(this->size_ - 1);
+  }
+
+  /// @brief Fetches reference to an item of the I-th column
+  /// @tparam I Column index
+  /// @param pos Row index
+  /// @return Reference to packed item
+  template <std::size_t I>
+  inline item_proxy<column_value_type<I>, column_type<I>::width> at(
+      std::size_t pos) noexcept {
+    using lane = lane_at<I>;
+    auto word_ptr = &this->columns_[I].data()[lane::word_index(pos)];
+    return impl::proxy_access::make<column_value_type<I>,
+                                    column_type<I>::width>(
+        word_ptr, lane::item_offset(pos));
+  }
+
+  /// @brief Fetches value of an item of the I-th column
+  /// @tparam I Column index
+  /// @param pos Row index
+  /// @return Extracted value
+  template <std::size_t I>
+  inline column_value_type<I> at(std::size_t pos) const noexcept {
+    using lane = lane_at<I>;
+    auto word_ptr = &this->columns_[I].data()[lane::word_index(pos)];
+    auto w_bits = lane::extract_value(word_ptr, lane::item_offset(pos));
+    return static_cast<column_value_type<I>>(w_bits);
+  }
+
+  /// @brief Fetches references to all items of a row
+  /// @param pos Row index
+  /// @return Tuple of references (one per column)
+  inline reference operator[](std::size_t pos) noexcept {
+    return this->row(pos, std::make_index_sequence<column_count_>{});
+  }
+
+  /// @brief Fetches values of all items of a row
+  /// @param pos Row index
+  /// @return Tuple of values (one per column)
+  inline value_type operator[](std::size_t pos) const noexcept {
+    return this->row(pos, std::make_index_sequence<column_count_>{});
+  }
+
+  /// @brief Fetches address of the I-th column's word array
+  /// @tparam I Column index
+  /// @return Const pointer to first word
+  template <std::size_t I>
+  inline const std::uintmax_t* column_data() const noexcept {
+    return this->columns_[I].data();
+  }
+
+  /// @brief Returns the number of words in use by the I-th column
+  /// @tparam I Column index
+  /// @return Word count
+  template <std::size_t I>
+  inline std::size_t column_word_count() const noexcept {
+    return lane_at<I>::words_for(this->size_);
+  }
+
+  /// @brief Visits every item of the I-th column in row order
+  /// @tparam I Column index
+  /// @tparam F Callable as `f(std::size_t row, T value)`
+  /// @param f Visitor
+  template <std::size_t I, typename F>
+  inline void scan(F&& f) const {
+    using lane = lane_at<I>;
+    using T = column_value_type<I>;
+
+    const std::uintmax_t* words = this->columns_[I].data();
+    std::size_t pos = 0;
+
+    for (std::size_t i = 0; pos < this->size_; ++i) {
+      auto offset = lane::front_offset;
+      auto end = pos + lane::per_word;
+      if (end > this->size_) end = this->size_;
+
+      for (; pos < end; ++pos, offset -= column_type<I>::width)
+        f(pos, static_cast<T>(lane::extract_value(&words[i], offset)));
+    }
+  }
+
+  /// @brief Counts items of the I-th column that satisfy a predicate
+  /// @tparam I Column index
+  /// @tparam Pred Callable as `pred(T value) -> bool`
+  /// @param pred Predicate
+  /// @return Number of matching rows
+  template <std::size_t I, typename Pred>
+  inline std::size_t count_if(Pred&& pred) const {
+    std::size_t count = 0;
+
+    this->scan<I>([&](std::size_t, column_value_type<I> value) {
+      count += (std::size_t)(bool)pred(value);
+    });
+
+    return count;
+  }
+
+  /// @brief Collects the rows whose I-th item satisfies a predicate
+  /// @tparam I Column index
+  /// @tparam Pred Callable as `pred(T value) -> bool`
+  /// @param pred Predicate
+  /// @param out_rows Output buffer (must hold up to `size()` indices)
+  /// @return Number of row indices written
+  template <std::size_t I, typename Pred>
+  inline std::size_t filter(Pred&& pred, std::size_t* out_rows) const {
+    std::size_t count = 0;
+
+    this->scan<I>([&](std::size_t row, column_value_type<I> value) {
+      out_rows[count] = row;
+      count += (std::size_t)(bool)pred(value);
+    });
+
+    return count;
+  }
+};
+
+}  // namespace bp3k
+
+#endif  // !_BITPACKER3000_TABLE_H_
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "bp3k_arena.h"
+#include "bp3k_auto.h"
+#include "bp3k_elias_fano.h"
+#include "bp3k_hash_map.h"
+#include "bp3k_pfor.h"
+#include "bp3k_table.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(ArenaTests, BumpAllocationIsWordAligned) {
+  bp3k::packed_arena arena(64);
+
+  auto a = arena.allocate(3, 1);
+  auto b = arena.allocate(5, 1);
+  auto c = arena.allocate(1000, 64);
+
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ((std::uintptr_t)a % alignof(std::uintmax_t), 0);
+  ASSERT_EQ((std::uintptr_t)b % alignof(std::uintmax_t), 0);
+  ASSERT_EQ((std::uintptr_t)c % 64, 0);
+  ASSERT_EQ(arena.bytes_allocated(), 1008);
+
+  arena.deallocate(b, 5, 1);
+  arena.release();
+  ASSERT_EQ(arena.bytes_allocated(), 0);
+  ASSERT_NE(arena.allocate(8, 8), nullptr);
+}
+
+TEST(ArenaTests, InitialBufferServedFirst) {
+  alignas(std::uintmax_t) unsigned char buffer[256];
+  bp3k::packed_arena arena(buffer, sizeof(buffer));
+
+  auto a = (unsigned char*)arena.allocate(128, 8);
+  ASSERT_GE(a, buffer);
+  ASSERT_LT(a, buffer + sizeof(buffer));
+
+  auto b = (unsigned char*)arena.allocate(512, 8);
+  ASSERT_TRUE(b < buffer || b >= buffer + sizeof(buffer));
+
+  arena.release();
+  ASSERT_EQ(arena.allocate(16, 8), buffer);
+}
+
+TEST(ArenaTests, PackersAllocateFromArena) {
+  bp3k::packed_arena arena;
+  std::vector<i32> values(1000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (i32)(i * 3) - 700;
+
+  auto buffer = pack_auto(values.data(), values.size(), &arena);
+  ASSERT_EQ(buffer.resource(), &arena);
+  ASSERT_EQ(buffer.size(), values.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(buffer[i], values[i]);
+
+  bp3k::pfor_packer<i32> pfor(&arena);
+  ASSERT_TRUE(pfor.encode(values.data(), values.size()));
+  ASSERT_EQ(pfor.at(999), values[999]);
+
+  bp3k::packed_table<column<u8, 3>, column<i16, 10>> table(&arena);
+  for (int i = 0; i < 300; ++i)
+    ASSERT_TRUE(table.push_back((u8)(i % 8), (i16)(i - 150)));
+  ASSERT_EQ(table.at<1>(299), 149);
+
+  bp3k::packed_hash_map<16, 8> map(&arena);
+  for (u16 key = 0; key < 500; ++key)
+    ASSERT_TRUE(map.insert_or_assign(key, (u8)key));
+  ASSERT_TRUE(map.contains(499));
+
+  std::vector<u64> sorted = {1, 4, 9, 16, 25, 36};
+  bp3k::elias_fano<> ef(&arena);
+  ASSERT_TRUE(ef.encode(sorted.data(), sorted.size()));
+  ASSERT_EQ(ef.resource(), &arena);
+  ASSERT_EQ(ef[5], 36);
+
+  ASSERT_GT(arena.bytes_allocated(), buffer.word_count() * 8);
+}
+
+TEST(ArenaTests, ThrowingResourceReportsFailure) {
+  bp3k::pfor_packer<u16> packer(std::pmr::null_memory_resource());
+  std::vector<u16> values(10, 7);
+
+  ASSERT_FALSE(packer.encode(values.data(), values.size()));
+  ASSERT_EQ(packer.size(), 0);
+}
+
+TEST(ArenaTests, ExhaustedArenaThrows) {
+  bp3k::packed_arena arena;
+  bp3k::pfor_packer<u16> packer(&arena);
+  std::vector<u16> values(10, 7);
+
+  // No heap can hold this, so the arena throws as memory_resource must
+  ASSERT_THROW((void)arena.allocate(~(std::size_t)0 >> 2, 8), std::bad_alloc);
+  ASSERT_THROW((void)arena.allocate(~(std::size_t)0 >> 1, 8), std::bad_alloc);
+
+  // A failed request leaves the arena usable
+  ASSERT_TRUE(packer.encode(values.data(), values.size()));
+  ASSERT_EQ(packer[9], 7);
+}
+
+TEST(ArenaTests, MoveKeepsResource) {
+  std::pmr::monotonic_buffer_resource pool;
+  bp3k::packed_hash_map<12, 4> map(&pool);
+
+  ASSERT_TRUE(map.insert_or_assign(7, 3));
+
+  auto moved = std::move(map);
+  ASSERT_EQ(moved.resource(), &pool);
+  ASSERT_TRUE(moved.contains(7));
+  ASSERT_EQ(map.resource(), nullptr);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,104 @@
+#include <vector>
+
+#include "bp3k_sliced.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+template <typename T>
+inline bool compare(bp3k::compare_op op, T x, T c) {
+  switch (op) {
+    case bp3k::compare_op::equal:
+      return x == c;
+    case bp3k::compare_op::not_equal:
+      return x != c;
+    case bp3k::compare_op::less:
+      return x < c;
+    case bp3k::compare_op::less_equal:
+      return x <= c;
+    case bp3k::compare_op::greater:
+      return x > c;
+    case bp3k::compare_op::greater_equal:
+      return x >= c;
+  }
+
+  return false;
+}
+
+constexpr bp3k::compare_op all_ops[] = {
+    bp3k::compare_op::equal,        bp3k::compare_op::not_equal,
+    bp3k::compare_op::less,         bp3k::compare_op::less_equal,
+    bp3k::compare_op::greater,      bp3k::compare_op::greater_equal,
+};
+
+TEST(BitSlicedTests, SetAndAt) {
+  bp3k::bitsliced_packer<i16, 11, 200> bp;
+
+  ASSERT_EQ(bp.block_count, 4);
+
+  for (std::size_t i = 0; i < bp.size(); ++i)
+    bp.set(i, (i16)((int)(i * 13 % 2048) - 1024));
+
+  for (std::size_t i = 0; i < bp.size(); ++i)
+    ASSERT_EQ(bp[i], (i16)((int)(i * 13 % 2048) - 1024));
+
+  bp.fill(bp.value_min);
+
+  for (std::size_t i = 0; i < bp.size(); ++i) ASSERT_EQ(bp[i], -1024);
+}
+
+TEST(BitSlicedTests, ScanMatchesScalarCompare) {
+  bp3k::bitsliced_packer<i8, 5, 150> bp;
+  std::vector<i8> values(bp.size());
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i8)((int)(i * 7 % 32) - 16);
+    bp.set(i, values[i]);
+  }
+
+  // Includes constants outside [-16, 15]
+  for (int c = -20; c <= 20; ++c) {
+    for (auto op : all_ops) {
+      std::uintmax_t out[bp.block_count]{};
+      std::size_t expected = 0;
+
+      auto matches = bp.scan(op, (i8)c, out);
+
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        bool hit = compare(op, values[i], (i8)c);
+        expected += hit;
+        ASSERT_EQ((bool)((out[i / 64] >> (i % 64)) & 1), hit);
+      }
+
+      ASSERT_EQ(matches, expected);
+    }
+  }
+}
+
+TEST(BitSlicedTests, UnsignedScanIgnoresPaddingLanes) {
+  bp3k::bitsliced_packer<u8, 3, 70> bp(0);
+
+  bp.set(69, 7);
+
+  ASSERT_EQ(bp.scan(bp3k::compare_op::equal, (u8)0, nullptr), 69);
+  ASSERT_EQ(bp.scan(bp3k::compare_op::greater, (u8)6, nullptr), 1);
+  ASSERT_EQ(bp.scan(bp3k::compare_op::less, (u8)200, nullptr), 70);
+
+  std::uintmax_t out[2]{};
+  ASSERT_EQ(bp.scan(bp3k::compare_op::not_equal, (u8)0, out), 1);
+  ASSERT_EQ(out[0], 0);
+  ASSERT_EQ(out[1], (std::uintmax_t)1 << 5);
+}
+
+TEST(BitSlicedTests, ScanBetween) {
+  bp3k::bitsliced_packer<u16, 10, 1000> bp;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) bp.set(i, (u16)i);
+
+  ASSERT_EQ(bp.scan_between(100, 199, nullptr), 100);
+  ASSERT_EQ(bp.scan_between(990, 2000, nullptr), 10);
+  ASSERT_EQ(bp.scan_between(5, 4, nullptr), 0);
+  ASSERT_EQ(bp.scan_between(1100, 1200, nullptr), 0);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "bp3k.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+template <typename Packer, typename F>
+void expect_unpack_matches(F&& make_value) {
+  using value_type = typename Packer::value_type;
+
+  auto bp = new Packer();
+
+  for (std::size_t i = 0; i < bp->size(); ++i) (*bp)[i] = make_value(i);
+
+  // Unaligned ranges take the per-item head/tail paths around table words
+  for (std::size_t pos : {0, 1, 7, 33}) {
+    auto count = bp->size() - pos - 3;
+    std::vector<value_type> out(count);
+
+    bp->unpack(pos, count, out.data());
+
+    for (std::size_t i = 0; i < count; ++i) ASSERT_EQ(out[i], (*bp)[pos + i]);
+  }
+
+  std::size_t i = 0;
+  bp->for_each([&](value_type x) { ASSERT_EQ(x, (*bp)[i++]); });
+  ASSERT_EQ(i, bp->size());
+
+  delete bp;
+}
+
+TEST(ByteTableTests, SignedTables) {
+  using lane = bp3k::impl::lane_dispatcher<i8, 2>;
+
+  // 0xe4 = 0b11'10'01'00 decodes to -1, -2, 1, 0
+  static_assert(bp3k::impl::byte_table_v<i8, 2, lane>.values[0xe4][0] == -1);
+  static_assert(bp3k::impl::byte_table_v<i8, 2, lane>.values[0xe4][1] == -2);
+
+  expect_unpack_matches<bp3k::ibitpacker<1, 1000>>(
+      [](std::size_t i) { return (i8)-(int)(i % 3 == 0); });
+  expect_unpack_matches<bp3k::ibitpacker<2, 1000>>(
+      [](std::size_t i) { return (i8)((int)(i % 4) - 2); });
+  expect_unpack_matches<bp3k::ibitpacker<4, 1000, bp3k::zigzag>>(
+      [](std::size_t i) { return (i8)((int)(i % 16) - 8); });
+}
+
+TEST(ByteTableTests, UnsignedAndEnumTables) {
+  expect_unpack_matches<bp3k::ubitpacker<1, 777>>(
+      [](std::size_t i) { return (u8)(i % 5 == 0); });
+  expect_unpack_matches<bp3k::bitpacker<u32, 4, 777>>(
+      [](std::size_t i) { return (u32)(i % 13); });
+  expect_unpack_matches<bp3k::bitpacker<u8enum, 2, 500>>(
+      [](std::size_t i) { return (u8enum)(i % 4); });
+}
+
+TEST(ByteTableTests, GenericWidthsStillUnpack) {
+  expect_unpack_matches<bp3k::ibitpacker<5, 1000>>(
+      [](std::size_t i) { return (i8)((int)(i % 32) - 16); });
+}
+
+TEST(ByteTableTests, Histogram) {
+  bp3k::ibitpacker<2, 301> signed_bp;
+  bp3k::ubitpacker<4, 301> unsigned_bp;
+  std::size_t signed_counts[4]{};
+  std::size_t unsigned_counts[16]{};
+
+  for (std::size_t i = 0; i < 301; ++i) {
+    signed_bp[i] = (i8)((int)(i % 4) - 2);
+    unsigned_bp[i] = (u8)(i % 16);
+  }
+
+  signed_bp.histogram(signed_counts);
+  unsigned_bp.histogram(unsigned_counts);
+
+  // Index 0 is value_min (-2)
+  ASSERT_EQ(signed_counts[0], 76);
+  ASSERT_EQ(signed_counts[1], 75);
+  ASSERT_EQ(signed_counts[2], 75);
+  ASSERT_EQ(signed_counts[3], 75);
+
+  for (std::size_t k = 0; k < 16; ++k)
+    ASSERT_EQ(unsigned_counts[k], 18 + (k < 13));
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,169 @@
+#include <thread>
+#include <vector>
+
+#include "bp3k_cow.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(CowTests, ResizeStartsWithZeroPages) {
+  bp3k::cow_packed_array<u16, 9, 4> arr;
+
+  ASSERT_TRUE(arr.empty());
+  ASSERT_EQ(arr.chunk_items, 28);
+  ASSERT_TRUE(arr.resize(100));
+  ASSERT_EQ(arr.size(), 100);
+  ASSERT_EQ(arr.chunk_count(), 4);
+
+  for (std::size_t i = 0; i < arr.size(); ++i) ASSERT_EQ(arr[i], 0);
+
+  ASSERT_TRUE(arr.set(57, 511));
+  ASSERT_EQ(arr[57], 511);
+  ASSERT_EQ(arr[56], 0);
+  ASSERT_EQ(arr[58], 0);
+}
+
+TEST(CowTests, SignedValuesRoundTrip) {
+  bp3k::cow_packed_array<i16, 11, 2> arr;
+  std::vector<i16> expected(500);
+
+  ASSERT_TRUE(arr.resize(expected.size()));
+
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = (i16)((int)(i * 37) % 2048 - 1024);
+    ASSERT_TRUE(arr.set(i, expected[i]));
+  }
+
+  std::vector<i16> decoded(expected.size());
+  arr.unpack(0, decoded.size(), decoded.data());
+  ASSERT_EQ(decoded, expected);
+
+  std::vector<i16> visited;
+  arr.for_each([&visited](i16 x) { visited.push_back(x); });
+  ASSERT_EQ(visited, expected);
+}
+
+TEST(CowTests, SnapshotKeepsOldValues) {
+  bp3k::cow_packed_array<u8, 4, 2> arr;
+  bp3k::cow_packed_array<u8, 4, 2>::snapshot_type snap;
+
+  ASSERT_TRUE(arr.resize(100));
+
+  for (std::size_t i = 0; i < 100; ++i) ASSERT_TRUE(arr.set(i, i % 16));
+
+  ASSERT_TRUE(arr.snapshot(snap));
+  ASSERT_EQ(snap.size(), 100);
+  ASSERT_EQ(arr.shared_chunks(), arr.chunk_count());
+
+  ASSERT_TRUE(arr.set(3, 15));
+  ASSERT_TRUE(arr.set(4, 15));
+  ASSERT_EQ(arr.shared_chunks(), arr.chunk_count() - 1);
+
+  ASSERT_EQ(arr[3], 15);
+  ASSERT_EQ(snap[3], 3);
+  ASSERT_EQ(snap[4], 4);
+
+  for (std::size_t i = 5; i < 100; ++i) ASSERT_EQ(snap[i], arr[i]);
+
+  snap = {};
+  ASSERT_EQ(arr.shared_chunks(), 0);
+  ASSERT_EQ(arr[3], 15);
+}
+
+TEST(CowTests, UntouchedPagesStayShared) {
+  bp3k::cow_packed_array<u32, 20, 8> arr;
+  bp3k::cow_snapshot<u32, 20, 8> first, second;
+
+  ASSERT_TRUE(arr.resize(1000));
+  ASSERT_TRUE(arr.set(999, 7));
+  ASSERT_TRUE(arr.snapshot(first));
+  ASSERT_TRUE(arr.set(0, 1));
+  ASSERT_TRUE(arr.snapshot(second));
+  ASSERT_TRUE(arr.set(0, 2));
+
+  ASSERT_EQ(first[0], 0);
+  ASSERT_EQ(second[0], 1);
+  ASSERT_EQ(arr[0], 2);
+  ASSERT_EQ(first[999], 7);
+  ASSERT_EQ(second[999], 7);
+  ASSERT_EQ(arr.shared_chunks(), 1);
+}
+
+TEST(CowTests, ShrinkClearsSharedTail) {
+  bp3k::cow_packed_array<u8, 8, 1> arr;
+  bp3k::cow_snapshot<u8, 8, 1> snap;
+
+  ASSERT_TRUE(arr.resize(20));
+
+  for (std::size_t i = 0; i < 20; ++i) ASSERT_TRUE(arr.set(i, 100 + i));
+
+  ASSERT_TRUE(arr.snapshot(snap));
+  ASSERT_TRUE(arr.resize(5));
+  ASSERT_EQ(arr.chunk_count(), 1);
+  ASSERT_TRUE(arr.resize(20));
+
+  for (std::size_t i = 0; i < 5; ++i) ASSERT_EQ(arr[i], 100 + i);
+  for (std::size_t i = 5; i < 20; ++i) ASSERT_EQ(arr[i], 0);
+  for (std::size_t i = 0; i < 20; ++i) ASSERT_EQ(snap[i], 100 + i);
+}
+
+TEST(CowTests, MoveTransfersPages) {
+  bp3k::cow_packed_array<i8enum, 2> arr;
+
+  ASSERT_TRUE(arr.resize(10));
+  ASSERT_TRUE(arr.set(9, i8enum::MinusOne));
+
+  auto moved = std::move(arr);
+
+  ASSERT_TRUE(arr.empty());
+  ASSERT_EQ(moved.size(), 10);
+  ASSERT_EQ(moved[9], i8enum::MinusOne);
+  ASSERT_EQ(moved[0], i8enum::Zero);
+}
+
+TEST(CowTests, ReadersSeeConsistentSnapshots) {
+  constexpr std::size_t count = 4096;
+  bp3k::cow_packed_array<u32, 24, 16> arr;
+  std::vector<bp3k::cow_snapshot<u32, 24, 16>> snaps(8);
+
+  ASSERT_TRUE(arr.resize(count));
+
+  for (u32 round = 0; round < snaps.size(); ++round) {
+    for (std::size_t i = round; i < count; i += 7)
+      ASSERT_TRUE(arr.set(i, round + 1));
+
+    ASSERT_TRUE(arr.snapshot(snaps[round]));
+  }
+
+  std::vector<std::vector<u32>> expected(snaps.size());
+
+  for (std::size_t s = 0; s < snaps.size(); ++s) {
+    expected[s].resize(count);
+    snaps[s].unpack(0, count, expected[s].data());
+  }
+
+  std::vector<std::thread> readers;
+  std::vector<int> mismatches(snaps.size());
+
+  for (std::size_t s = 0; s < snaps.size(); ++s) {
+    readers.emplace_back([&, s] {
+      for (int pass = 0; pass < 20; ++pass) {
+        for (std::size_t i = 0; i < count; ++i)
+          mismatches[s] += snaps[s][i] != expected[s][i];
+      }
+
+      snaps[s] = {};
+    });
+  }
+
+  // The writer keeps mutating while readers walk and drop their snapshots
+  for (u32 round = 0; round < 200; ++round)
+    ASSERT_TRUE(arr.set((round * 131) % count, round));
+
+  for (auto& reader : readers) reader.join();
+
+  for (auto m : mismatches) ASSERT_EQ(m, 0);
+  ASSERT_EQ(arr.shared_chunks(), 0);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,57 @@
+#include <vector>
+
+#include "bp3k_dict.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+enum class opcode : i16 { nop = 0, read = 100, write = 1000, reset = -5 };
+
+using opcode_dict = bp3k::enum_dictionary<opcode, opcode::nop, opcode::read,
+                                          opcode::write, opcode::reset>;
+
+TEST(DictPackerTests, DictionaryTables) {
+  static_assert(opcode_dict::size == 4);
+  static_assert(opcode_dict::width == 2);
+  static_assert(opcode_dict::contains(opcode::reset));
+  static_assert(!opcode_dict::contains((opcode)7));
+  static_assert(opcode_dict::decode(2) == opcode::write);
+
+  opcode_dict::code_type code = 9;
+  ASSERT_TRUE(opcode_dict::encode(opcode::reset, code));
+  ASSERT_EQ(code, 3);
+  ASSERT_FALSE(opcode_dict::encode((opcode)-1, code));
+  ASSERT_EQ(code, 3);
+
+  ASSERT_EQ((bp3k::enum_dictionary<u32, 42>::width), 1);
+  ASSERT_EQ((bp3k::enum_dictionary<i32, 1, 2, 3, 4, 5>::width), 3);
+}
+
+TEST(DictPackerTests, SetAtAndUnpack) {
+  bp3k::dict_packer<opcode_dict, 1000> bp;
+  const opcode ops[] = {opcode::write, opcode::reset, opcode::nop,
+                        opcode::read, opcode::reset};
+
+  // 2 bits per element instead of 16
+  ASSERT_EQ(sizeof(bp), sizeof(bp3k::bitpacker<u8, 2, 1000>));
+  ASSERT_EQ(bp[999], opcode::nop);
+
+  for (std::size_t i = 0; i < bp.size(); ++i)
+    ASSERT_TRUE(bp.set(i, ops[i % 5]));
+
+  ASSERT_FALSE(bp.set(3, (opcode)1));
+  ASSERT_EQ(bp[3], opcode::read);
+
+  std::vector<opcode> out(bp.size() - 10);
+  bp.unpack(10, out.size(), out.data());
+
+  for (std::size_t i = 0; i < out.size(); ++i)
+    ASSERT_EQ(out[i], ops[(i + 10) % 5]);
+
+  ASSERT_TRUE(bp.fill(opcode::reset));
+  ASSERT_FALSE(bp.fill((opcode)2));
+  ASSERT_EQ(bp.codes()[500], 3);
+  ASSERT_EQ(bp.at(500), opcode::reset);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <vector>
+
+#include "bp3k_elias_fano.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+inline std::vector<u64> sorted_sequence(std::size_t count, u64 max_gap) {
+  std::vector<u64> values(count);
+  std::uint64_t state = 2463534242ull;
+  u64 x = 0;
+
+  for (auto& v : values) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    x += state % (max_gap + 1);
+    v = x;
+  }
+
+  return values;
+}
+
+TEST(EliasFanoTests, RandomAccessAndIteration) {
+  auto values = sorted_sequence(5000, 300);
+  bp3k::elias_fano<> ef;
+
+  ASSERT_TRUE(ef.encode(values.data(), values.size()));
+  ASSERT_EQ(ef.size(), values.size());
+  ASSERT_GT(ef.low_width(), 0);
+
+  for (std::size_t i = 0; i < values.size(); ++i) ASSERT_EQ(ef[i], values[i]);
+
+  std::vector<u64> decoded(ef.begin(), ef.end());
+  ASSERT_EQ(decoded, values);
+
+  // Roughly 2 + log2(u / n) bits per value
+  ASSERT_LT(ef.bytes_used() * 8, values.size() * (ef.low_width() + 3));
+}
+
+TEST(EliasFanoTests, NextGeq) {
+  auto values = sorted_sequence(3000, 40);
+  bp3k::elias_fano<u64> ef;
+
+  ASSERT_TRUE(ef.encode(values.data(), values.size()));
+
+  for (u64 x = 0; x <= values.back() + 5; x += 3) {
+    auto expected = std::lower_bound(values.begin(), values.end(), x);
+    auto it = ef.next_geq(x);
+
+    if (expected == values.end()) {
+      ASSERT_EQ(it, ef.end());
+    } else {
+      ASSERT_EQ(it.index(), (std::size_t)(expected - values.begin()));
+      ASSERT_EQ(*it, *expected);
+    }
+  }
+}
+
+TEST(EliasFanoTests, DuplicatesAndDenseValues) {
+  std::vector<u32> values = {0, 0, 0, 1, 1, 2, 7, 7, 7, 7};
+  bp3k::elias_fano<u32> ef;
+
+  ASSERT_TRUE(ef.encode(values.data(), values.size()));
+  ASSERT_EQ(ef.low_width(), 0);
+
+  for (std::size_t i = 0; i < values.size(); ++i) ASSERT_EQ(ef[i], values[i]);
+
+  ASSERT_EQ(ef.next_geq(1).index(), 3);
+  ASSERT_EQ(ef.next_geq(3).index(), 6);
+  ASSERT_EQ(ef.next_geq(8), ef.end());
+}
+
+TEST(EliasFanoTests, RejectsDecreasingAndHandlesEmpty) {
+  std::vector<u16> bad = {1, 5, 4};
+  std::vector<u16> good = {10, 20};
+  bp3k::elias_fano<u16> ef;
+
+  ASSERT_TRUE(ef.encode(good.data(), good.size()));
+  ASSERT_FALSE(ef.encode(bad.data(), bad.size()));
+  ASSERT_EQ(ef.size(), 2);
+
+  ASSERT_TRUE(ef.encode(nullptr, 0));
+  ASSERT_TRUE(ef.empty());
+  ASSERT_EQ(ef.begin(), ef.end());
+  ASSERT_EQ(ef.next_geq(0), ef.end());
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bp3k_file.h"
+#include "bp3k_stream.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+inline std::string temp_path(const char* name) {
+  return ::testing::TempDir() + name;
+}
+
+inline std::vector<char> read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+}
+
+TEST(FileSinkTests, WritesBytesInOrder) {
+  auto path = temp_path("bp3k_file_sink_bytes.bin");
+  bp3k::file_sink sink(4096, 3);
+  std::vector<char> expected(50000);
+
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    expected[i] = (char)(i * 7);
+
+  ASSERT_TRUE(sink.open(path.c_str()));
+  ASSERT_TRUE(sink.is_open());
+
+  for (std::size_t i = 0; i < expected.size(); i += 1000)
+    ASSERT_TRUE(sink.write(&expected[i], 1000));
+
+  ASSERT_TRUE(sink.close());
+  ASSERT_FALSE(sink.is_open());
+  ASSERT_FALSE(sink.write(expected.data(), 1));
+  ASSERT_EQ(read_file(path), expected);
+
+  std::remove(path.c_str());
+}
+
+TEST(FileSinkTests, TryWriteAppliesBackPressure) {
+  auto path = temp_path("bp3k_file_sink_try.bin");
+  bp3k::file_sink sink(4096, 2);
+  std::vector<char> bytes(3 * 4096);
+
+  ASSERT_TRUE(sink.open(path.c_str()));
+
+  // More than all buffers together can ever hold at once
+  ASSERT_FALSE(sink.try_write(bytes.data(), bytes.size()));
+  ASSERT_TRUE(sink.try_write(bytes.data(), 100));
+  ASSERT_TRUE(sink.close());
+  ASSERT_EQ(read_file(path).size(), 100);
+
+  std::remove(path.c_str());
+}
+
+TEST(FileSinkTests, FailedWriteStopsTheSink) {
+  bp3k::file_sink sink(4096, 2);
+  std::vector<char> bytes(4096, 'x');
+
+  if (!sink.open("/dev/full")) GTEST_SKIP() << "/dev/full unavailable";
+
+  // The device rejects every write; later buffers are dropped, not retried
+  bool accepted = true;
+
+  for (int i = 0; i < 16 && accepted; ++i)
+    accepted = sink.write(bytes.data(), bytes.size());
+
+  ASSERT_FALSE(sink.close());
+}
+
+TEST(FileSinkTests, DirectWritesPartialTail) {
+  auto path = temp_path("bp3k_file_sink_direct.bin");
+  bp3k::file_sink sink(4096, 2);
+  std::vector<char> expected(3 * 4096 + 123, 'x');
+
+  if (!sink.open(path.c_str(), true))
+    GTEST_SKIP() << "O_DIRECT unsupported here";
+
+  ASSERT_TRUE(sink.write(expected.data(), expected.size()));
+  ASSERT_TRUE(sink.close());
+  ASSERT_EQ(read_file(path), expected);
+
+  std::remove(path.c_str());
+}
+
+TEST(FileSinkTests, PackedWriterChunks) {
+  auto path = temp_path("bp3k_file_sink_chunks.bin");
+  bp3k::file_sink sink(8192, 2);
+  std::vector<u16> values(10000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (u16)(i % 1024);
+
+  ASSERT_TRUE(sink.open(path.c_str()));
+
+  {
+    bp3k::packed_writer<u16, 10, bp3k::file_chunk_sink<10>, 64> writer(
+        bp3k::file_chunk_sink<10>{sink});
+    writer.push(values.data(), values.size());
+    writer.flush();
+    ASSERT_TRUE(writer.sink().ok());
+  }
+
+  ASSERT_TRUE(sink.close());
+
+  auto bytes = read_file(path);
+  ASSERT_EQ(bytes.size(), (10000 + 5) / 6 * sizeof(std::uintmax_t));
+
+  std::vector<std::uintmax_t> words(bytes.size() / sizeof(std::uintmax_t));
+  std::memcpy(words.data(), bytes.data(), bytes.size());
+
+  bp3k::packed_reader<u16, 10> reader(words.data(), values.size());
+  std::vector<u16> decoded(values.size());
+
+  ASSERT_EQ(reader.read(decoded.data(), decoded.size()), values.size());
+  ASSERT_EQ(decoded, values);
+
+  std::remove(path.c_str());
+}
+
+TEST(FileSinkTests, PackedWriterLatchesFailure) {
+  bp3k::file_sink sink(4096, 2);
+  std::vector<u16> values(1000, 7);
+
+  // Never opened, so every write is rejected
+  bp3k::packed_writer<u16, 10, bp3k::file_chunk_sink<10>, 64> writer(
+      bp3k::file_chunk_sink<10>{sink});
+
+  ASSERT_TRUE(writer.sink().ok());
+  writer.push(values.data(), values.size());
+  writer.flush();
+  ASSERT_FALSE(writer.sink().ok());
+}
+
+}  // namespace bp3k::tests
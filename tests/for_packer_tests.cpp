@@ -0,0 +1,101 @@
+#include "bp3k_for.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+// 40-bit timestamps with small gaps
+template <std::size_t N>
+inline std::array<u64, N> make_timestamps(u64 step_mod) {
+  std::array<u64, N> values{};
+  std::mt19937 rng{1337};
+  u64 t = 0xAB12345678;
+
+  for (auto& v : values) {
+    t += rng() % step_mod;
+    v = t;
+  }
+
+  return values;
+}
+
+TEST(ForPackerTests, EncodeDecodeRoundTrip) {
+  constexpr std::size_t N = 1000;
+  auto values = make_timestamps<N>(16);
+  bp3k::for_packer<u64, 12, N, 128> packer;
+
+  ASSERT_TRUE(packer.encode(values.data()));
+  ASSERT_EQ(packer.block_count, 8);
+
+  std::array<u64, N> decoded{};
+  packer.decode(decoded.data());
+
+  for (std::size_t i = 0; i < N; ++i) {
+    ASSERT_EQ(decoded[i], values[i]);
+    ASSERT_EQ(packer[i], values[i]);
+  }
+
+  ASSERT_EQ(packer.base(0), values[0]);
+  ASSERT_LT(sizeof(packer), sizeof(values) / 3);
+}
+
+TEST(ForPackerTests, EncodeRejectsWideBlock) {
+  std::array<i32, 20> values{};
+  bp3k::for_packer<i32, 4, 20, 8> packer;
+
+  values[3] = -16;
+
+  ASSERT_FALSE(packer.encode(values.data()));
+  ASSERT_EQ(packer[3], 0);
+
+  values[3] = -15;
+
+  ASSERT_TRUE(packer.encode(values.data()));
+  ASSERT_EQ(packer[3], -15);
+  ASSERT_EQ(packer[4], 0);
+}
+
+TEST(ForPackerTests, SetWithinFrame) {
+  std::array<u32, 10> values{100, 101, 102, 103, 104, 105, 106, 107, 108, 109};
+  bp3k::for_packer<u32, 4, 10, 5> packer;
+
+  ASSERT_TRUE(packer.encode(values.data()));
+  ASSERT_TRUE(packer.set(2, 115));
+  ASSERT_EQ(packer[2], 115);
+  ASSERT_FALSE(packer.set(2, 116));
+  ASSERT_FALSE(packer.set(2, 99));
+  ASSERT_EQ(packer[2], 115);
+}
+
+TEST(DeltaPackerTests, EncodeDecodeRoundTrip) {
+  constexpr std::size_t N = 1000;
+  auto values = make_timestamps<N>(2048);
+  bp3k::delta_packer<u64, 12, N, 64> packer;
+
+  ASSERT_TRUE(packer.encode(values.data()));
+
+  std::array<u64, N> decoded{};
+  packer.decode(decoded.data());
+
+  for (std::size_t i = 0; i < N; ++i) {
+    ASSERT_EQ(decoded[i], values[i]);
+    ASSERT_EQ(packer[i], values[i]);
+  }
+}
+
+TEST(DeltaPackerTests, SignedDifferences) {
+  std::array<i16, 9> values{0, -5, 3, -4, 4, -3, 5, 300, 301};
+  bp3k::delta_packer<i16, 5, 9, 7> packer;
+
+  // 300 follows a checkpoint, the rest stay within [-16, 15]
+  ASSERT_TRUE(packer.encode(values.data()));
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(packer[i], values[i]);
+
+  values[3] = 20;
+
+  ASSERT_FALSE(packer.encode(values.data()));
+  ASSERT_EQ(packer[3], -4);
+}
+
+}  // namespace bp3k::tests
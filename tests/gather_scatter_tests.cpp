@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <vector>
+
+#include "bp3k.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+inline std::vector<std::size_t> random_indices(std::size_t count,
+                                               std::size_t bound) {
+  std::vector<std::size_t> indices(count);
+  std::uint64_t state = 88172645463325252ull;
+
+  for (auto& i : indices) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    i = (std::size_t)(state % bound);
+  }
+
+  return indices;
+}
+
+TEST(GatherScatterTests, GatherMatchesAt) {
+  auto bp = new bp3k::bitpacker<i32, 19, 50000>();
+
+  for (std::size_t i = 0; i < bp->size(); ++i)
+    (*bp)[i] = (i32)((i * 37) % 500000) - 250000;
+
+  // Not a multiple of the batch size, so the tail batch is exercised
+  auto indices = random_indices(1003, bp->size());
+  std::vector<i32> out(indices.size());
+
+  bp->gather(indices.data(), indices.size(), out.data());
+
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    ASSERT_EQ(out[i], bp->at(indices[i]));
+
+  delete bp;
+}
+
+TEST(GatherScatterTests, SortedIndicesShareWords) {
+  bp3k::bitpacker<u8, 3, 1000> bp;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) bp[i] = (u8)(i % 8);
+
+  auto indices = random_indices(500, bp.size());
+  std::sort(indices.begin(), indices.end());
+
+  std::vector<u8> out(indices.size());
+  bp.gather(indices.data(), indices.size(), out.data());
+
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    ASSERT_EQ(out[i], (u8)(indices[i] % 8));
+}
+
+TEST(GatherScatterTests, ScatterMatchesAssignment) {
+  bp3k::bitpacker<i16, 9, 4000, bp3k::zigzag> expected;
+  bp3k::bitpacker<i16, 9, 4000, bp3k::zigzag> actual;
+  auto indices = random_indices(777, expected.size());
+  std::vector<i16> values(indices.size());
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (i16)((int)(i % 512) - 256);
+
+  // Duplicated indices keep the last value, as sequential stores would
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    expected[indices[i]] = values[i];
+
+  actual.scatter(indices.data(), indices.size(), values.data());
+
+  ASSERT_EQ(actual, expected);
+}
+
+TEST(GatherScatterTests, EmptyBatch) {
+  using packer = bp3k::bitpacker<u16, 12, 10>;
+  packer bp(7);
+
+  bp.gather(nullptr, 0, nullptr);
+  bp.scatter(nullptr, 0, nullptr);
+
+  ASSERT_EQ(bp, packer(7));
+}
+
+}  // namespace bp3k::tests
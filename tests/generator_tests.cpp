@@ -0,0 +1,99 @@
+#include <vector>
+
+#include "bp3k_auto.h"
+#include "bp3k_generator.h"
+#include "bp3k_small_vector.h"
+#include "bp3k_stream.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+#if BP3K_HAS_COROUTINES
+
+TEST(GeneratorTests, DecodesInBlocks) {
+  bitpacker<u16, 10, 1000> bp;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) bp[i] = (u16)(i % 1024);
+
+  auto gen = decode_blocks<128>(bp);
+  std::vector<std::size_t> sizes;
+  std::vector<u16> seen;
+
+  ASSERT_TRUE(gen.valid());
+
+  while (gen.next()) {
+    sizes.push_back(gen.block().size());
+    for (auto x : gen.block()) seen.push_back(x);
+  }
+
+  ASSERT_EQ(sizes.size(), 8);
+  ASSERT_EQ(sizes.back(), 1000 - 7 * 128);
+  ASSERT_EQ(seen.size(), bp.size());
+  for (std::size_t i = 0; i < bp.size(); ++i) ASSERT_EQ(seen[i], bp[i]);
+  ASSERT_FALSE(gen.next());
+}
+
+TEST(GeneratorTests, FallsBackToAt) {
+  std::vector<i32> values = {-5, 100, 7, 7, -1000, 3};
+  auto buffer = pack_auto(values.data(), values.size());
+  std::vector<i32> seen;
+
+  auto gen = decode_blocks<4>(buffer);
+  while (gen.next())
+    for (auto x : gen.block()) seen.push_back(x);
+
+  ASSERT_EQ(seen, values);
+}
+
+TEST(GeneratorTests, FilterTransformFeed) {
+  small_packed_vector<i16, 12, 4> vec;
+
+  for (int i = 0; i < 3000; ++i) ASSERT_TRUE(vec.push_back((i16)(i - 1500)));
+
+  using lane = impl::lane_dispatcher<u32, 20>;
+  std::vector<u32> encoded_items;
+  auto sink = [&](const std::uintmax_t* words, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+      encoded_items.push_back(lane::extract_value(
+          &words[lane::word_index(i)], lane::item_offset(i)));
+  };
+
+  auto evens = filter_blocks(decode_blocks<256>(vec),
+                             [](i16 x) { return x % 2 == 0; });
+  auto squares = transform_blocks(std::move(evens), [](i16 x) {
+    return (u32)(x * x) & 0xfffff;
+  });
+
+  packed_writer<u32, 20, decltype(sink), 16> writer(sink);
+  ASSERT_EQ(feed(squares, writer), 1500);
+  writer.flush();
+
+  ASSERT_EQ(encoded_items.size(), 1500);
+  for (std::size_t i = 0; i < encoded_items.size(); ++i) {
+    auto x = (int)(i * 2) - 1500;
+    ASSERT_EQ(encoded_items[i], (u32)(x * x) & 0xfffff);
+  }
+}
+
+TEST(GeneratorTests, EmptySources) {
+  small_packed_vector<u8, 4, 1> empty;
+  block_generator<u8> none;
+
+  auto gen = decode_blocks(empty);
+  ASSERT_FALSE(gen.next());
+  ASSERT_FALSE(none.valid());
+  ASSERT_FALSE(none.next());
+
+  auto filtered = filter_blocks(decode_blocks(empty), [](u8) { return true; });
+  ASSERT_FALSE(filtered.next());
+}
+
+#else
+
+TEST(GeneratorTests, RequiresCoroutines) {
+  GTEST_SKIP() << "C++20 coroutines are unavailable on this toolchain";
+}
+
+#endif  // BP3K_HAS_COROUTINES
+
+}  // namespace bp3k::tests
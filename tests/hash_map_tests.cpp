@@ -0,0 +1,106 @@
+#include <unordered_map>
+#include <utility>
+
+#include "bp3k_hash_map.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(HashMapTests, InsertFindAssign) {
+  bp3k::packed_hash_map<20, 10> map;
+  u16 value = 0;
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_FALSE(map.find(5, value));
+  ASSERT_FALSE(map.erase(5));
+
+  ASSERT_TRUE(map.insert_or_assign(5, 700));
+  ASSERT_TRUE(map.insert_or_assign(1048575, 1023));
+  ASSERT_EQ(map.size(), 2);
+
+  ASSERT_TRUE(map.find(5, value));
+  ASSERT_EQ(value, 700);
+  ASSERT_TRUE(map.find(1048575, value));
+  ASSERT_EQ(value, 1023);
+
+  ASSERT_TRUE(map.insert_or_assign(5, 1));
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_TRUE(map.find(5, value));
+  ASSERT_EQ(value, 1);
+}
+
+TEST(HashMapTests, MatchesUnorderedMap) {
+  bp3k::packed_hash_map<20, 10> map;
+  std::unordered_map<u32, u16> expected;
+  std::uint64_t state = 12345;
+
+  for (int i = 0; i < 200000; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    auto key = (u32)((state >> 20) & 0xfffff);
+    auto value = (u16)((state >> 50) & 0x3ff);
+
+    // Mix inserts with occasional erases
+    if ((state >> 40) % 8 == 0) {
+      ASSERT_EQ(map.erase(key), expected.erase(key) == 1);
+    } else {
+      ASSERT_TRUE(map.insert_or_assign(key, value));
+      expected[key] = value;
+    }
+  }
+
+  ASSERT_EQ(map.size(), expected.size());
+  ASSERT_LE(map.size() * 16, map.capacity() * 15);
+
+  for (const auto& [key, value] : expected) {
+    u16 found = 0;
+    ASSERT_TRUE(map.find(key, found));
+    ASSERT_EQ(found, value);
+  }
+
+  std::size_t visited = 0;
+  map.for_each([&](u32 key, u16 value) {
+    ASSERT_EQ(expected.at(key), value);
+    ++visited;
+  });
+  ASSERT_EQ(visited, expected.size());
+}
+
+TEST(HashMapTests, HighLoadFootprint) {
+  bp3k::packed_hash_map<20, 10> map;
+
+  ASSERT_TRUE(map.reserve(900000));
+  ASSERT_EQ(map.capacity(), 1 << 20);
+
+  for (u32 key = 0; key < 900000; ++key)
+    ASSERT_TRUE(map.insert_or_assign(key, (u16)(key & 0x3ff)));
+
+  // Load factor above 0.85 with no rehash
+  ASSERT_EQ(map.capacity(), 1 << 20);
+  ASSERT_LT((double)map.bytes_used() / map.size(), 7.0);
+
+  for (u32 key = 0; key < 900000; key += 7) {
+    u16 value = 0;
+    ASSERT_TRUE(map.find(key, value));
+    ASSERT_EQ(value, (u16)(key & 0x3ff));
+  }
+}
+
+TEST(HashMapTests, ClearAndMove) {
+  bp3k::packed_hash_map<8, 4> map;
+
+  for (u8 key = 0; key < 200; ++key) ASSERT_TRUE(map.insert_or_assign(key, 3));
+
+  auto moved = std::move(map);
+  ASSERT_EQ(map.size(), 0);
+  ASSERT_EQ(map.capacity(), 0);
+  ASSERT_EQ(moved.size(), 200);
+  ASSERT_TRUE(moved.contains(199));
+
+  moved.clear();
+  ASSERT_TRUE(moved.empty());
+  ASSERT_FALSE(moved.contains(199));
+  ASSERT_TRUE(moved.insert_or_assign(199, 2));
+  ASSERT_TRUE(moved.contains(199));
+}
+
+}  // namespace bp3k::tests
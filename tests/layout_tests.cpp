@@ -0,0 +1,65 @@
+#include <cstdint>
+
+#include "bp3k.h"
+#include "bp3k_parallel.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+using default_layout = bitpacker<u8, 5, 100>;
+using aligned_layout = cache_aligned_bitpacker<u8, 5, 100>;
+
+// Budgets can be checked at compile time
+static_assert(default_layout::layout.word_count == 9);
+static_assert(default_layout::layout.bytes_used == sizeof(default_layout));
+static_assert(aligned_layout::layout.bytes_used == sizeof(aligned_layout));
+static_assert(aligned_layout::layout.density() < 1.0);
+
+TEST(LayoutTests, DefaultLayoutFigures) {
+  constexpr auto layout = default_layout::layout;
+
+  ASSERT_EQ(layout.item_count, 100);
+  ASSERT_EQ(layout.width, 5);
+  ASSERT_EQ(layout.per_word, 12);
+  ASSERT_EQ(layout.alignment, alignof(std::uintmax_t));
+  ASSERT_EQ(layout.bytes_used, 72);
+  ASSERT_EQ(layout.min_bytes, 63);
+  ASSERT_EQ(layout.wasted_bits, 72 * 8 - 500);
+  ASSERT_EQ(layout.cache_lines, 2);
+  ASSERT_DOUBLE_EQ(layout.density(), 500.0 / 576.0);
+}
+
+TEST(LayoutTests, PowerOfTwoWidthIsDense) {
+  constexpr auto layout = bitpacker<u8, 4, 32>::layout;
+
+  ASSERT_EQ(layout.wasted_bits, 0);
+  ASSERT_DOUBLE_EQ(layout.density(), 1.0);
+}
+
+TEST(LayoutTests, CacheAlignedPackers) {
+  constexpr auto layout = aligned_layout::layout;
+
+  ASSERT_EQ(layout.alignment, cache_line_size);
+  ASSERT_EQ(layout.bytes_used, 128);
+  ASSERT_EQ(layout.cache_lines, 2);
+  ASSERT_EQ(alignof(aligned_layout), cache_line_size);
+
+  aligned_layout packers[3];
+
+  for (auto& bp : packers)
+    ASSERT_EQ((std::uintptr_t)bp.data() % cache_line_size, 0);
+
+  packers[1][99] = 31;
+  packers[2] = packers[1];
+  ASSERT_TRUE(packers[1] == packers[2]);
+  ASSERT_TRUE(packers[0] < packers[1]);
+  ASSERT_EQ(packers[2][99], 31);
+
+  parallel::fill(packers[0], (u8)7, sequential_executor{});
+  ASSERT_EQ(parallel::count(
+                packers[0], [](u8 x) { return x == 7; },
+                sequential_executor{}),
+            100);
+}
+
+}  // namespace bp3k::tests
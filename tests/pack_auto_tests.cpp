@@ -0,0 +1,124 @@
+#include <memory_resource>
+#include <vector>
+
+#include "bp3k_auto.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+template <typename T>
+inline void expect_round_trip(const std::vector<T>& values,
+                              const bp3k::packed_buffer<T>& packed) {
+  std::vector<T> decoded(values.size());
+
+  packed.decode(decoded.data());
+
+  ASSERT_EQ(packed.size(), values.size());
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(decoded[i], values[i]);
+    ASSERT_EQ(packed[i], values[i]);
+  }
+}
+
+TEST(PackAutoTests, AnalyzeWidths) {
+  std::vector<i32> values{-5, 3, 7, -1};
+  auto analysis = bp3k::analyze_width(values.data(), values.size());
+
+  ASSERT_EQ(analysis.min, -5);
+  ASSERT_EQ(analysis.max, 7);
+  ASSERT_EQ(analysis.unsigned_width, 0);
+  ASSERT_EQ(analysis.signed_width, 4);
+  ASSERT_EQ(analysis.for_width, 4);
+  ASSERT_EQ(analysis.scheme, bp3k::pack_scheme::signed_bits);
+  ASSERT_EQ(analysis.width, 4);
+}
+
+TEST(PackAutoTests, AnalyzeUnsignedTopBit) {
+  std::vector<u64> values{1, ~(u64)0};
+  auto analysis = bp3k::analyze_width(values.data(), values.size());
+
+  ASSERT_EQ(analysis.unsigned_width, 64);
+  ASSERT_EQ(analysis.signed_width, 0);
+  ASSERT_EQ(analysis.scheme, bp3k::pack_scheme::unsigned_bits);
+  ASSERT_EQ(analysis.width, 64);
+}
+
+TEST(PackAutoTests, UnsignedValues) {
+  std::vector<u16> values{0, 1, 2, 3, 4, 5, 6, 7, 0, 7};
+  auto packed = bp3k::pack_auto(values.data(), values.size());
+
+  ASSERT_EQ(packed.scheme(), bp3k::pack_scheme::unsigned_bits);
+  ASSERT_EQ(packed.width(), 3);
+  ASSERT_EQ(packed.word_count(), 1);
+  expect_round_trip(values, packed);
+}
+
+TEST(PackAutoTests, SignedValues) {
+  std::vector<i64> values(100);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (i64)(i % 2 ? -(i64)i : (i64)i);
+
+  auto packed = bp3k::pack_auto(values.data(), values.size());
+
+  ASSERT_EQ(packed.scheme(), bp3k::pack_scheme::signed_bits);
+  ASSERT_EQ(packed.width(), 8);
+  expect_round_trip(values, packed);
+}
+
+TEST(PackAutoTests, FrameOfReferenceTimestamps) {
+  std::vector<u64> values(500);
+  u64 t = 0xAB12345678;
+
+  for (auto& v : values) v = t++;
+
+  auto packed = bp3k::pack_auto(values.data(), values.size());
+
+  ASSERT_EQ(packed.scheme(), bp3k::pack_scheme::frame_of_reference);
+  ASSERT_EQ(packed.width(), 9);
+  ASSERT_EQ(packed.base(), values[0]);
+  expect_round_trip(values, packed);
+}
+
+TEST(PackAutoTests, ConstantAndEmptyInputs) {
+  std::vector<i8> values(10, (i8)-128);
+  auto packed = bp3k::pack_auto(values.data(), values.size());
+
+  ASSERT_EQ(packed.width(), 1);
+  expect_round_trip(values, packed);
+
+  auto empty = bp3k::pack_auto(values.data(), 0);
+
+  ASSERT_TRUE(empty.empty());
+  ASSERT_TRUE(empty.valid());
+  ASSERT_EQ(empty.word_count(), 0);
+}
+
+TEST(PackAutoTests, AllocationFailureIsReported) {
+  std::vector<u32> values(100, 12345);
+  auto packed = bp3k::pack_auto(values.data(), values.size(),
+                                std::pmr::null_memory_resource());
+
+  ASSERT_FALSE(packed.valid());
+  ASSERT_TRUE(packed.empty());
+
+  auto moved = std::move(packed);
+  ASSERT_FALSE(moved.valid());
+}
+
+TEST(PackAutoTests, WideBitPackerLanes) {
+  bp3k::bitpacker<u64, 40, 5> bp;
+  bp3k::bitpacker<i32, 32, 3> ibp;
+
+  bp[3] = 0xAB12345678;
+  ibp[1] = INT32_MIN;
+
+  ASSERT_EQ(bp[3], 0xAB12345678ull);
+  ASSERT_EQ(bp[2], 0ull);
+  ASSERT_EQ(ibp[1], INT32_MIN);
+  ASSERT_EQ((decltype(ibp)::value_min), INT32_MIN);
+  ASSERT_EQ((decltype(ibp)::value_max), INT32_MAX);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,116 @@
+#include "bp3k_table.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+using table_type =
+    bp3k::packed_table<column<u8, 3>, column<i16, 10>, column<i8enum, 4>>;
+
+TEST(PackedTableTests, DefaultIsEmpty) {
+  table_type table;
+
+  ASSERT_TRUE(table.empty());
+  ASSERT_EQ(table.size(), 0);
+  ASSERT_EQ(table.column_count(), 3);
+}
+
+TEST(PackedTableTests, PushBackAndRowAccess) {
+  table_type table;
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    auto e = static_cast<i8enum>((int)(i % 16) - 8);
+    ASSERT_TRUE(table.push_back((u8)(i % 8), (i16)(i * 5 - 250), e));
+  }
+
+  ASSERT_EQ(table.size(), 100);
+  ASSERT_GE(table.capacity(), 100);
+
+  const auto& ctable = table;
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    auto [a, b, c] = ctable[i];
+    ASSERT_EQ(a, (u8)(i % 8));
+    ASSERT_EQ(b, (i16)(i * 5 - 250));
+    ASSERT_EQ(c, static_cast<i8enum>((int)(i % 16) - 8));
+  }
+}
+
+TEST(PackedTableTests, RowReferenceAssignment) {
+  table_type table;
+
+  ASSERT_TRUE(table.resize(20));
+
+  auto row = table[7];
+  std::get<0>(row) = (u8)5;
+  std::get<1>(row) = (i16)-300;
+  std::get<2>(row) = i8enum::Seven;
+
+  ASSERT_EQ(table.at<0>(7), (u8)5);
+  ASSERT_EQ(table.at<1>(7), (i16)-300);
+  ASSERT_EQ(table.at<2>(7), i8enum::Seven);
+  ASSERT_EQ(table.at<1>(6), (i16)0);
+  ASSERT_EQ(table.at<1>(8), (i16)0);
+}
+
+TEST(PackedTableTests, ResizeZeroesNewRows) {
+  table_type table;
+
+  for (std::size_t i = 0; i < 40; ++i)
+    ASSERT_TRUE(table.push_back((u8)7, (i16)-1, i8enum::MinusOne));
+
+  ASSERT_TRUE(table.resize(3));
+  ASSERT_TRUE(table.resize(40));
+
+  for (std::size_t i = 3; i < 40; ++i) {
+    auto [a, b, c] = static_cast<const table_type&>(table)[i];
+    ASSERT_EQ(a, (u8)0);
+    ASSERT_EQ(b, (i16)0);
+    ASSERT_EQ(c, i8enum::Zero);
+  }
+
+  table.pop_back();
+  ASSERT_EQ(table.size(), 39);
+
+  table.clear();
+  ASSERT_TRUE(table.empty());
+}
+
+TEST(PackedTableTests, ColumnScanAndFilter) {
+  table_type table;
+
+  for (std::size_t i = 0; i < 77; ++i)
+    ASSERT_TRUE(table.push_back((u8)(i % 8), (i16)i, i8enum::Zero));
+
+  std::size_t visited = 0;
+
+  table.scan<1>([&](std::size_t row, i16 value) {
+    ASSERT_EQ((i16)row, value);
+    ++visited;
+  });
+
+  ASSERT_EQ(visited, 77);
+  ASSERT_EQ(table.count_if<0>([](u8 v) { return v == 3; }), 10);
+
+  std::array<std::size_t, 77> rows{};
+  auto count = table.filter<0>([](u8 v) { return v == 3; }, rows.data());
+
+  ASSERT_EQ(count, 10);
+
+  for (std::size_t i = 0; i < count; ++i) ASSERT_EQ(rows[i] % 8, 3);
+
+  ASSERT_EQ(table.column_word_count<0>(), (77 + 20) / 21);
+  ASSERT_NE(table.column_data<0>(), nullptr);
+}
+
+TEST(PackedTableTests, MoveTransfersRows) {
+  table_type table;
+
+  ASSERT_TRUE(table.push_back((u8)1, (i16)2, i8enum::Three));
+
+  table_type moved(std::move(table));
+
+  ASSERT_EQ(moved.size(), 1);
+  ASSERT_EQ(moved.at<2>(0), i8enum::Three);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bp3k_parallel.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(ParallelTests, ThreadPoolRunsEveryTaskOnce) {
+  bp3k::thread_pool pool(4);
+  std::vector<std::atomic<int>> hits(1000);
+
+  ASSERT_EQ(pool.size(), 4);
+
+  for (int round = 0; round < 20; ++round)
+    pool(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+
+  for (auto& h : hits) ASSERT_EQ(h.load(), 20);
+}
+
+TEST(ParallelTests, FillAndCopy) {
+  bp3k::thread_pool pool(3);
+  auto src = new bp3k::bitpacker<i16, 11, 100003>();
+  auto dst = new bp3k::bitpacker<i16, 11, 100003>();
+
+  bp3k::parallel::fill(*src, (i16)-700, pool, 1000);
+
+  for (std::size_t i = 0; i < src->size(); ++i) ASSERT_EQ((*src)[i], -700);
+
+  // Unused lanes of the last word stay zero, as with `fill()`
+  bp3k::bitpacker<i16, 11, 100003> expected;
+  expected.fill((i16)-700);
+  ASSERT_EQ(*src, expected);
+
+  (*src)[12345] = 3;
+  bp3k::parallel::copy(*src, *dst, pool, 1000);
+  ASSERT_EQ(*src, *dst);
+
+  delete src;
+  delete dst;
+}
+
+TEST(ParallelTests, TransformAcrossWidths) {
+  bp3k::thread_pool pool(4);
+  bp3k::bitpacker<u8, 7, 5000> src;
+  bp3k::bitpacker<u16, 13, 5000> dst;
+
+  for (std::size_t i = 0; i < src.size(); ++i) src[i] = (u8)(i % 128);
+
+  // Lanes differ in width, so task ranges must respect both word grids
+  bp3k::parallel::transform(
+      src, dst, [](u8 x) { return (u16)(x * 50); }, pool, 100);
+
+  for (std::size_t i = 0; i < dst.size(); ++i)
+    ASSERT_EQ(dst[i], (u16)((i % 128) * 50));
+}
+
+TEST(ParallelTests, ReduceAndCount) {
+  bp3k::thread_pool pool(4);
+  bp3k::bitpacker<i32, 20, 30000> bp;
+  std::int64_t sum = 0;
+  std::size_t negatives = 0;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) {
+    auto x = (i32)((i * 7919) % 1000000) - 500000;
+    bp[i] = x;
+    sum += x;
+    negatives += x < 0;
+  }
+
+  auto plus = [](std::int64_t a, std::int64_t b) { return a + b; };
+  auto is_negative = [](i32 x) { return x < 0; };
+
+  ASSERT_EQ(bp3k::parallel::reduce(bp, std::int64_t{0}, plus, pool, 512),
+            sum);
+  ASSERT_EQ(bp3k::parallel::count(bp, is_negative, pool, 512), negatives);
+
+  // Any executor works, including the sequential one
+  bp3k::sequential_executor seq;
+  ASSERT_EQ(bp3k::parallel::reduce(bp, std::int64_t{0}, plus, seq), sum);
+  ASSERT_EQ(bp3k::parallel::count(bp, is_negative, seq), negatives);
+}
+
+TEST(ParallelTests, ZeroWorkerPoolRunsInline) {
+  bp3k::thread_pool pool(0);
+  bp3k::bitpacker<u8, 3, 100> bp;
+
+  ASSERT_EQ(pool.size(), 0);
+
+  bp3k::parallel::fill(bp, (u8)5, pool, 1);
+  ASSERT_EQ(bp3k::parallel::count(
+                bp, [](u8 x) { return x == 5; }, pool, 1),
+            100);
+}
+
+TEST(ParallelTests, ReduceWithoutDefaultConstructor) {
+  struct sum final {
+    std::int64_t value;
+
+    explicit sum(std::int64_t v) : value(v) {}
+  };
+
+  bp3k::thread_pool pool(3);
+  bp3k::bitpacker<u16, 12, 100000> bp;
+
+  bp3k::parallel::fill(bp, (u16)3, pool, 1000);
+
+  auto plus = [](sum acc, auto x) {
+    if constexpr (std::is_same<decltype(x), sum>::value)
+      return sum(acc.value + x.value);
+    else
+      return sum(acc.value + x);
+  };
+
+  // The grain asks for 100 tasks; reduce caps them at max_reduce_tasks
+  auto total = bp3k::parallel::reduce(bp, sum(0), plus, pool, 1000);
+  ASSERT_EQ(total.value, 300000);
+}
+
+TEST(ParallelTests, DefaultPoolLeavesCoreForSubmitter) {
+  bp3k::thread_pool pool;
+  std::size_t cores = std::thread::hardware_concurrency();
+
+  ASSERT_EQ(pool.size(), cores != 0 ? cores - 1 : 0);
+}
+
+}  // namespace bp3k::tests
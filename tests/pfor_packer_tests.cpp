@@ -0,0 +1,85 @@
+#include <vector>
+
+#include "bp3k_pfor.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(PForPackerTests, DefaultIsEmpty) {
+  bp3k::pfor_packer<u32> packer;
+
+  ASSERT_TRUE(packer.empty());
+  ASSERT_EQ(packer.block_count(), 0);
+}
+
+TEST(PForPackerTests, OutliersBecomeExceptions) {
+  std::vector<u32> values(1000);
+  std::mt19937 rng{1337};
+
+  for (auto& v : values) v = 5000 + rng() % 64;
+
+  values[17] = 0xFFFFFFF0;
+  values[300] = 1u << 30;
+  values[999] = 123456789;
+
+  bp3k::pfor_packer<u32, 128> packer;
+
+  ASSERT_TRUE(packer.encode(values.data(), values.size()));
+  ASSERT_EQ(packer.size(), values.size());
+  ASSERT_EQ(packer.block_count(), 8);
+
+  // Outliers must not widen their blocks
+  for (std::size_t b = 0; b < packer.block_count(); ++b)
+    ASSERT_LE(packer.block_width(b), 7);
+
+  ASSERT_GE(packer.exception_count(), 3);
+  ASSERT_LT(packer.bytes_used(), values.size() * sizeof(u32) / 3);
+
+  std::vector<u32> decoded(values.size());
+  packer.decode(decoded.data());
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(decoded[i], values[i]);
+    ASSERT_EQ(packer[i], values[i]);
+  }
+}
+
+TEST(PForPackerTests, SignedAndConstantBlocks) {
+  std::vector<i16> values(300, (i16)-42);
+
+  for (std::size_t i = 128; i < 256; ++i) values[i] = (i16)(i % 2 ? -3 : 3);
+
+  values[260] = INT16_MIN;
+  values[261] = INT16_MAX;
+
+  bp3k::pfor_packer<i16, 128> packer;
+
+  ASSERT_TRUE(packer.encode(values.data(), values.size()));
+  ASSERT_EQ(packer.block_width(0), 0);
+  ASSERT_EQ(packer.block_width(1), 3);
+
+  std::vector<i16> decoded(values.size());
+  packer.decode(decoded.data());
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(decoded[i], values[i]);
+    ASSERT_EQ(packer.at(i), values[i]);
+  }
+}
+
+TEST(PForPackerTests, MoveTransfersContents) {
+  std::vector<u8> values{1, 2, 3, 250, 4, 5};
+  bp3k::pfor_packer<u8, 4> packer;
+
+  ASSERT_TRUE(packer.encode(values.data(), values.size()));
+
+  bp3k::pfor_packer<u8, 4> moved(std::move(packer));
+
+  ASSERT_TRUE(packer.empty());
+  ASSERT_EQ(moved.size(), values.size());
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(moved[i], values[i]);
+}
+
+}  // namespace bp3k::tests
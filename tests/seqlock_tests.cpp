@@ -0,0 +1,110 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bp3k_seqlock.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(SeqlockTests, LayoutConstants) {
+  using packer = bp3k::seqlock_packer<u16, 12, 100>;
+
+  ASSERT_EQ(packer::word_count, 20);
+  ASSERT_EQ(packer::block_items, 40);
+  ASSERT_EQ(packer::block_count, 3);
+  ASSERT_EQ(alignof(packer), bp3k::cache_line_size);
+
+  // Each counter has a cache line to itself
+  ASSERT_EQ(sizeof(packer), (3 + 3) * bp3k::cache_line_size);
+}
+
+TEST(SeqlockTests, StoreLoadAndVersions) {
+  bp3k::seqlock_packer<i8, 5, 50, 1> packer;
+
+  ASSERT_EQ(packer.size(), 50);
+  ASSERT_EQ(packer.version(0), 0);
+
+  packer.store(0, -16);
+  packer.store(49, 15);
+
+  ASSERT_EQ(packer[0], -16);
+  ASSERT_EQ(packer.load(49), 15);
+  ASSERT_EQ(packer[1], 0);
+  ASSERT_EQ(packer.version(0), 2);
+  ASSERT_EQ(packer.version(49), 2);
+  ASSERT_EQ(packer.version(20), 0);
+}
+
+TEST(SeqlockTests, RangeWriteAndRead) {
+  bp3k::seqlock_packer<u32, 17, 300, 2, bp3k::twos_complement> packer;
+  std::vector<u32> values(120), out(120);
+
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = (u32)(i * 1001);
+
+  packer.write(37, values.size(), values.data());
+
+  ASSERT_TRUE(packer.try_read(37, out.size(), out.data()));
+  ASSERT_EQ(out, values);
+  ASSERT_EQ(packer.read(37, out.size(), out.data()), 0);
+  ASSERT_EQ(out, values);
+  ASSERT_EQ(packer[36], 0);
+  ASSERT_EQ(packer[157], 0);
+
+  packer.fill(5);
+
+  for (std::size_t i = 0; i < packer.size(); ++i) ASSERT_EQ(packer[i], 5);
+}
+
+TEST(SeqlockTests, ZigzagAndEnums) {
+  bp3k::seqlock_packer<i16, 6, 40, 8, bp3k::zigzag> packer;
+  bp3k::seqlock_packer<u8enum, 3, 10> enums;
+
+  packer.store(7, -32);
+  packer.store(8, 31);
+  enums.store(9, u8enum::Two);
+
+  ASSERT_EQ(packer[7], -32);
+  ASSERT_EQ(packer[8], 31);
+  ASSERT_EQ(enums[9], u8enum::Two);
+  ASSERT_EQ(enums[0], u8enum::Zero);
+}
+
+TEST(SeqlockTests, ReadersNeverSeeTornRows) {
+  constexpr std::size_t row = 24;
+  constexpr std::size_t rows = 16;
+  bp3k::seqlock_packer<u32, 20, row * rows, 2> packer;
+  std::atomic<bool> stop{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&, r] {
+      u32 out[row];
+
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto first = (r * 5 % rows) * row;
+        packer.read(first, row, out);
+
+        // Every write stores one value across the whole row
+        for (std::size_t i = 1; i < row; ++i) torn += out[i] != out[0];
+      }
+    });
+  }
+
+  u32 values[row];
+
+  for (u32 round = 1; round <= 20000; ++round) {
+    for (auto& x : values) x = round & 0xfffff;
+
+    packer.write((round % rows) * row, row, values);
+  }
+
+  stop = true;
+
+  for (auto& reader : readers) reader.join();
+
+  ASSERT_EQ(torn.load(), 0);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "bp3k_set_ops.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+template <typename T, std::size_t W, std::size_t N>
+inline std::vector<T> sorted_packed(bitpacker<T, W, N>& bp, std::size_t count,
+                                    std::uint64_t seed, std::uint64_t gap) {
+  std::vector<T> values(count);
+  std::uint64_t x = 0;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    x += (seed >> 33) % (gap + 1);
+    values[i] = (T)x;
+    bp[i] = values[i];
+  }
+
+  return values;
+}
+
+template <typename T, std::size_t W, std::size_t N>
+inline std::vector<T> decoded(const bitpacker<T, W, N>& bp,
+                              std::size_t count) {
+  std::vector<T> values(count);
+  bp.unpack(0, count, values.data());
+  return values;
+}
+
+TEST(SetOpsTests, MergeMatchesStd) {
+  bitpacker<u32, 20, 3000> a;
+  bitpacker<u32, 20, 2000> b;
+  auto va = sorted_packed(a, 3000, 1, 3);
+  auto vb = sorted_packed(b, 2000, 2, 5);
+
+  bitpacker<u32, 20, 5000> out;
+  std::vector<u32> expected;
+
+  auto n = intersect(a, b, out);
+  std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(),
+                        std::back_inserter(expected));
+  ASSERT_EQ(decoded(out, n), expected);
+  for (auto i = n; i < out.size(); ++i) ASSERT_EQ(out[i], 0);
+
+  expected.clear();
+  n = unite(a, b, out);
+  std::set_union(va.begin(), va.end(), vb.begin(), vb.end(),
+                 std::back_inserter(expected));
+  ASSERT_EQ(decoded(out, n), expected);
+
+  expected.clear();
+  n = difference(a, b, out);
+  std::set_difference(va.begin(), va.end(), vb.begin(), vb.end(),
+                      std::back_inserter(expected));
+  ASSERT_EQ(decoded(out, n), expected);
+}
+
+TEST(SetOpsTests, GallopingIntersection) {
+  bitpacker<u16, 13, 40> small;
+  bitpacker<u16, 13, 5000> large;
+  bitpacker<u16, 13, 40> out;
+  auto vs = sorted_packed(small, 40, 3, 200);
+  auto vl = sorted_packed(large, 5000, 4, 1);
+  std::vector<u16> expected;
+
+  std::set_intersection(vs.begin(), vs.end(), vl.begin(), vl.end(),
+                        std::back_inserter(expected));
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(decoded(out, intersect(small, large, out)), expected);
+  ASSERT_EQ(decoded(out, intersect(large, small, out)), expected);
+}
+
+TEST(SetOpsTests, PartialCountsAndEmptyInputs) {
+  const i16 va[] = {-5, -1, 0, 3, 7};
+  const i16 vb[] = {-1, 3, 4};
+  bitpacker<i16, 9, 8> a, b;
+  bitpacker<i16, 9, 16> out;
+
+  for (std::size_t i = 0; i < 5; ++i) a[i] = va[i];
+  for (std::size_t i = 0; i < 3; ++i) b[i] = vb[i];
+
+  ASSERT_EQ(intersect(a, b, out, 5, 3), 2);
+  ASSERT_EQ(out[0], -1);
+  ASSERT_EQ(out[1], 3);
+
+  ASSERT_EQ(unite(a, b, out, 5, 3), 6);
+  ASSERT_EQ(decoded(out, 6), (std::vector<i16>{-5, -1, 0, 3, 4, 7}));
+
+  ASSERT_EQ(difference(a, b, out, 5, 3), 3);
+  ASSERT_EQ(decoded(out, 3), (std::vector<i16>{-5, 0, 7}));
+
+  ASSERT_EQ(intersect(a, b, out, 0, 3), 0);
+  ASSERT_EQ(unite(a, b, out, 0, 0), 0);
+  ASSERT_EQ(difference(a, b, out, 5, 0), 5);
+  ASSERT_EQ(out[4], 7);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,138 @@
+#include <thread>
+#include <vector>
+
+#include "bp3k_sketch.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(SketchTests, CountingBloomInsertEraseSaturate) {
+  bp3k::counting_bloom<4, 4096, 3> bloom;
+
+  ASSERT_EQ(bloom.counter_max, 15);
+  ASSERT_FALSE(bloom.contains(42));
+
+  bloom.insert(42);
+  bloom.insert(42);
+  ASSERT_TRUE(bloom.contains(42));
+  ASSERT_GE(bloom.count(42), 2);
+
+  bloom.erase(42);
+  bloom.erase(42);
+  ASSERT_FALSE(bloom.contains(42));
+
+  // Saturated counters never go back down
+  for (int i = 0; i < 40; ++i) bloom.insert(7);
+
+  ASSERT_EQ(bloom.count(7), 15);
+  bloom.erase(7);
+  ASSERT_EQ(bloom.count(7), 15);
+}
+
+TEST(SketchTests, CountingBloomBatchMatchesSingle) {
+  bp3k::counting_bloom<8, 10007> single;
+  bp3k::counting_bloom<8, 10007> batched;
+  std::vector<std::uint64_t> keys(1000);
+
+  for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = i * 31 % 400;
+
+  for (auto key : keys) single.insert(key);
+
+  batched.insert(keys.data(), keys.size());
+
+  for (std::size_t pos = 0; pos < 10007; ++pos)
+    ASSERT_EQ(single.cell(pos), batched.cell(pos));
+
+  // No false negatives
+  for (auto key : keys) ASSERT_TRUE(batched.contains(key));
+}
+
+TEST(SketchTests, HalveShiftsEveryLane) {
+  bp3k::counting_bloom<3, 100, 1> bloom;
+
+  // Fill neighbouring lanes so bits would leak across them
+  for (std::uint64_t key = 0; key < 1000; ++key) bloom.insert(key);
+
+  std::vector<unsigned> before(100);
+  for (std::size_t pos = 0; pos < 100; ++pos) before[pos] = bloom.cell(pos);
+
+  bloom.halve();
+
+  for (std::size_t pos = 0; pos < 100; ++pos)
+    ASSERT_EQ(bloom.cell(pos), before[pos] / 2);
+}
+
+TEST(SketchTests, CountMinEstimates) {
+  bp3k::count_min<8, 4, 1024> sketch;
+  std::vector<std::uint64_t> keys;
+
+  for (std::uint64_t key = 0; key < 50; ++key)
+    for (std::uint64_t n = 0; n <= key; ++n) keys.push_back(key);
+
+  sketch.increment(keys.data(), keys.size());
+
+  for (std::uint64_t key = 0; key < 50; ++key) {
+    ASSERT_GE(sketch.estimate(key), key + 1);
+    ASSERT_LE(sketch.estimate(key), key + 10);
+  }
+
+  sketch.halve();
+  ASSERT_GE(sketch.estimate(49), 25);
+
+  sketch.clear();
+  ASSERT_EQ(sketch.estimate(49), 0);
+}
+
+TEST(SketchTests, AtomicIncrementsAcrossThreads) {
+  auto sketch = new bp3k::count_min<8, 2, 64>();
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([sketch] {
+      for (int i = 0; i < 50; ++i)
+        for (std::uint64_t key = 0; key < 8; ++key)
+          sketch->increment_atomic(key);
+    });
+  }
+
+  for (auto& t : threads) t.join();
+
+  // Sharing words between keys must not lose updates
+  for (std::uint64_t key = 0; key < 8; ++key)
+    ASSERT_GE(sketch->estimate(key), 200);
+
+  delete sketch;
+}
+
+TEST(SketchTests, AtomicReadsAlongsideWriters) {
+  auto bloom = new bp3k::counting_bloom<4, 256, 3>();
+  std::vector<std::thread> threads;
+
+  bloom->insert_atomic(7);
+
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([bloom] {
+      for (std::uint64_t key = 100; key < 2000; ++key) {
+        bloom->insert_atomic(key);
+        bloom->erase_atomic(key);
+      }
+    });
+  }
+
+  threads.emplace_back([bloom] {
+    for (int i = 0; i < 2000; ++i) ASSERT_TRUE(bloom->contains_atomic(7));
+  });
+
+  for (auto& t : threads) t.join();
+
+  auto before = bloom->count_atomic(7);
+
+  ASSERT_GE(before, 1);
+  bloom->halve_atomic();
+  ASSERT_EQ(bloom->count_atomic(7), before / 2);
+  ASSERT_EQ(bloom->count(7), bloom->count_atomic(7));
+
+  delete bloom;
+}
+
+}  // namespace bp3k::tests
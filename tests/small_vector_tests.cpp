@@ -0,0 +1,123 @@
+#include <vector>
+
+#include "bp3k_arena.h"
+#include "bp3k_small_vector.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(SmallVectorTests, StaysInlineUpToCapacity) {
+  bp3k::small_packed_vector<u8, 5, 2> vec;
+
+  ASSERT_TRUE(vec.empty());
+  ASSERT_EQ(vec.inline_capacity, 24);
+  ASSERT_EQ(vec.capacity(), 24);
+
+  for (u8 i = 0; i < 24; ++i) ASSERT_TRUE(vec.push_back(i));
+
+  ASSERT_TRUE(vec.is_inline());
+  ASSERT_EQ(vec.front(), 0);
+  ASSERT_EQ(vec.back(), 23);
+
+  ASSERT_TRUE(vec.push_back(31));
+  ASSERT_FALSE(vec.is_inline());
+  ASSERT_EQ(vec.capacity(), 48);
+
+  for (u8 i = 0; i < 24; ++i) ASSERT_EQ(vec[i], i);
+  ASSERT_EQ(vec[24], 31);
+}
+
+TEST(SmallVectorTests, SignedValuesAndProxies) {
+  bp3k::small_packed_vector<i16, 11, 1> vec;
+  std::vector<i16> expected;
+
+  for (int i = 0; i < 1000; ++i) {
+    auto x = (i16)((i * 37) % 2048 - 1024);
+    ASSERT_TRUE(vec.push_back(x));
+    expected.push_back(x);
+  }
+
+  vec[500] = -1024;
+  expected[500] = -1024;
+  vec.back() = vec.front();
+  expected.back() = expected.front();
+
+  std::vector<i16> decoded(vec.size());
+  vec.unpack(0, vec.size(), decoded.data());
+  ASSERT_EQ(decoded, expected);
+
+  std::size_t indices[] = {999, 3, 500};
+  i16 gathered[3];
+  vec.gather(indices, 3, gathered);
+  ASSERT_EQ(gathered[0], expected[999]);
+  ASSERT_EQ(gathered[2], -1024);
+}
+
+TEST(SmallVectorTests, ResizePopAndFill) {
+  bp3k::small_packed_vector<u8, 3, 1> vec;
+
+  ASSERT_TRUE(vec.resize(30));
+  ASSERT_EQ(vec.size(), 30);
+  ASSERT_FALSE(vec.is_inline());
+
+  vec.fill(5);
+  for (std::size_t i = 0; i < 30; ++i) ASSERT_EQ(vec[i], 5);
+
+  vec.pop_back();
+  ASSERT_EQ(vec.size(), 29);
+  ASSERT_TRUE(vec.resize(30));
+  ASSERT_EQ(vec.back(), 0);
+
+  ASSERT_TRUE(vec.resize(10));
+  ASSERT_TRUE(vec.resize(30));
+  ASSERT_EQ(vec[9], 5);
+  ASSERT_EQ(vec[10], 0);
+
+  vec.clear();
+  ASSERT_TRUE(vec.empty());
+}
+
+TEST(SmallVectorTests, PopBackOnEmptyIsNoOp) {
+  bp3k::small_packed_vector<u8, 3, 1> vec;
+
+  vec.pop_back();
+  ASSERT_TRUE(vec.empty());
+  ASSERT_TRUE(vec.push_back(6));
+  ASSERT_EQ(vec.size(), 1);
+  ASSERT_EQ(vec[0], 6);
+
+  vec.pop_back();
+  vec.pop_back();
+  ASSERT_TRUE(vec.empty());
+  ASSERT_TRUE(vec.is_inline());
+}
+
+TEST(SmallVectorTests, MoveEqualityAndArena) {
+  bp3k::packed_arena arena;
+  bp3k::small_packed_vector<u16, 12, 2> a(&arena), b;
+
+  for (u16 i = 0; i < 100; ++i) {
+    ASSERT_TRUE(a.push_back(i * 40));
+    ASSERT_TRUE(b.push_back(i * 40));
+  }
+
+  ASSERT_GT(arena.bytes_allocated(), 0);
+  ASSERT_TRUE(a == b);
+
+  b[50] = 1;
+  ASSERT_TRUE(a != b);
+
+  auto moved = std::move(a);
+  ASSERT_EQ(moved.resource(), &arena);
+  ASSERT_EQ(moved.size(), 100);
+  ASSERT_EQ(moved[99], 3960);
+  ASSERT_TRUE(a.empty());
+
+  bp3k::small_packed_vector<u16, 12, 2> small;
+  ASSERT_TRUE(small.push_back(7));
+  auto moved_small = std::move(small);
+  ASSERT_TRUE(moved_small.is_inline());
+  ASSERT_EQ(moved_small[0], 7);
+}
+
+}  // namespace bp3k::tests
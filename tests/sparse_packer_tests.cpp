@@ -0,0 +1,94 @@
+#include <memory_resource>
+#include <utility>
+
+#include "bp3k_sparse.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(SparsePackerTests, DefaultConstructed) {
+  bp3k::sparse_packer<i8enum, 4, 64> board(i8enum::MinusOne);
+
+  ASSERT_EQ(board.exception_count(), 0);
+  ASSERT_EQ(board[0], i8enum::MinusOne);
+  ASSERT_EQ(board[63], i8enum::MinusOne);
+}
+
+TEST(SparsePackerTests, BoardIsSmallerThanDense) {
+  using board_type = bp3k::sparse_packer<i8enum, 4, 64>;
+
+  // Bitmap, exception pointer, count and default: no rank index
+  static_assert(sizeof(board_type) < sizeof(bp3k::bitpacker<i8enum, 4, 64>));
+  static_assert(sizeof(board_type) <= 3 * sizeof(std::uintmax_t));
+
+  bp3k::bitpacker<i8enum, 4, 64> bp(i8enum::MinusOne);
+  bp[0] = i8enum::Seven;
+  bp[63] = i8enum::MinusEight;
+
+  board_type board;
+  ASSERT_TRUE(board.compress(bp, i8enum::MinusOne));
+  ASSERT_EQ(board.resource(), nullptr);
+  ASSERT_EQ(board.exception_count(), 2);
+  ASSERT_EQ(board[0], i8enum::Seven);
+  ASSERT_EQ(board[1], i8enum::MinusOne);
+  ASSERT_EQ(board[63], i8enum::MinusEight);
+}
+
+TEST(SparsePackerTests, CompressExpandRoundTrip) {
+  auto bp = new bp3k::bitpacker<i16, 12, 10000>(-3);
+
+  // Sprinkle exceptions across several rank spans
+  for (std::size_t i = 0; i < bp->size(); i += 97) (*bp)[i] = (i16)(i % 2000);
+
+  bp3k::sparse_packer<i16, 12, 10000> sparse;
+  ASSERT_TRUE(sparse.compress(*bp, -3));
+  ASSERT_EQ(sparse.default_value(), -3);
+  ASSERT_EQ(sparse.exception_count(), (10000 + 96) / 97);
+
+  for (std::size_t i = 0; i < bp->size(); ++i) ASSERT_EQ(sparse[i], (*bp)[i]);
+
+  ASSERT_LT(sparse.bytes_used(), sizeof(*bp) / 4);
+
+  auto expanded = new bp3k::bitpacker<i16, 12, 10000>();
+  sparse.expand(*expanded);
+  ASSERT_EQ(*expanded, *bp);
+
+  delete bp;
+  delete expanded;
+}
+
+TEST(SparsePackerTests, CompressAroundFrontAndMove) {
+  bp3k::bitpacker<u8, 3, 200, bp3k::twos_complement> bp(5);
+  bp[3] = 0;
+  bp[199] = 7;
+
+  bp3k::sparse_packer<u8, 3, 200> sparse;
+  ASSERT_TRUE(sparse.compress(bp));
+  ASSERT_EQ(sparse.default_value(), 5);
+  ASSERT_EQ(sparse.exception_count(), 2);
+
+  auto moved = std::move(sparse);
+  ASSERT_EQ(sparse.exception_count(), 0);
+  ASSERT_EQ(moved[3], 0);
+  ASSERT_EQ(moved[199], 7);
+  ASSERT_EQ(moved[100], 5);
+}
+
+TEST(SparsePackerTests, LargePackerUsesResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  bp3k::bitpacker<u8, 3, 2000> bp;
+  bp[1999] = 6;
+
+  bp3k::sparse_packer<u8, 3, 2000> sparse(0, &arena);
+  ASSERT_EQ(sparse.resource(), &arena);
+  ASSERT_TRUE(sparse.compress(bp));
+  ASSERT_EQ(sparse[1999], 6);
+  ASSERT_EQ(sparse[1998], 0);
+
+  bp3k::sparse_packer<u8, 3, 2000> failing(0,
+                                           std::pmr::null_memory_resource());
+  ASSERT_FALSE(failing.compress(bp));
+  ASSERT_EQ(failing.exception_count(), 0);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,107 @@
+#include <vector>
+
+#include "bp3k_stream.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+struct chunk_collector {
+  std::vector<std::vector<std::uintmax_t>>* chunks;
+  std::vector<std::size_t>* counts;
+
+  void operator()(const std::uintmax_t* words, std::size_t item_count) {
+    auto per_word = (sizeof(std::uintmax_t) << 3) / 3;
+    auto word_count = (item_count + per_word - 1) / per_word;
+
+    chunks->emplace_back(words, words + word_count);
+    counts->push_back(item_count);
+  }
+};
+
+TEST(StreamTests, SingleAndBatchPushRoundTrip) {
+  std::vector<std::vector<std::uintmax_t>> chunks;
+  std::vector<std::size_t> counts;
+  std::vector<i8> values(1000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (i8)((int)(i % 8) - 4);
+
+  {
+    bp3k::packed_writer<i8, 3, chunk_collector, 4> writer(
+        chunk_collector{&chunks, &counts});
+
+    ASSERT_EQ(writer.chunk_items, 84);
+
+    for (std::size_t i = 0; i < 5; ++i) writer.push(values[i]);
+
+    writer.push(&values[5], values.size() - 5);
+
+    ASSERT_EQ(writer.size(), values.size());
+  }
+
+  // 11 full chunks, then the flushed remainder
+  ASSERT_EQ(chunks.size(), 12);
+  ASSERT_EQ(counts.back(), 1000 - 11 * 84);
+
+  std::vector<i8> decoded;
+  std::array<i8, 10> buffer{};
+
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    bp3k::packed_reader<i8, 3> reader(chunks[c].data(), counts[c]);
+    std::size_t n = 0;
+
+    while ((n = reader.read(buffer.data(), buffer.size())) != 0)
+      decoded.insert(decoded.end(), buffer.begin(), buffer.begin() + n);
+
+    ASSERT_EQ(reader.remaining(), 0);
+  }
+
+  ASSERT_EQ(decoded, values);
+}
+
+TEST(StreamTests, ChunksMatchBitPackerLayout) {
+  std::vector<std::uintmax_t> words;
+  std::size_t items = 0;
+  auto sink = [&](const std::uintmax_t* w, std::size_t n) {
+    words.assign(w, w + (n + 3) / 4);
+    items = n;
+  };
+
+  bp3k::bitpacker<u16, 16, 10> expected;
+  bp3k::packed_writer<u16, 16, decltype(sink)> writer(sink);
+
+  for (std::size_t i = 0; i < 10; ++i) {
+    expected[i] = (u16)(i * 1000);
+    writer.push((u16)(i * 1000));
+  }
+
+  writer.flush();
+
+  ASSERT_EQ(items, 10);
+  ASSERT_EQ(words.size(), 3);
+
+  for (std::size_t i = 0; i < 3; ++i) ASSERT_EQ(words[i], expected.data()[i]);
+}
+
+TEST(StreamTests, ZigZagStream) {
+  std::vector<std::uintmax_t> words;
+  std::size_t items = 0;
+  auto sink = [&](const std::uintmax_t* w, std::size_t n) {
+    words.assign(w, w + 1);
+    items = n;
+  };
+
+  bp3k::packed_writer<i16, 5, decltype(sink), 8, bp3k::zigzag> writer(sink);
+  writer.push((i16)-16);
+  writer.push((i16)15);
+  writer.flush();
+
+  bp3k::packed_reader<i16, 5, bp3k::zigzag> reader(words.data(), items);
+  std::array<i16, 2> out{};
+
+  ASSERT_EQ(reader.read(out.data(), out.size()), 2);
+  ASSERT_EQ(out[0], (i16)-16);
+  ASSERT_EQ(out[1], (i16)15);
+}
+
+}  // namespace bp3k::tests
@@ -0,0 +1,80 @@
+#include <vector>
+
+#include "bp3k.h"
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(WordItemsTests, LoadMatchesAt) {
+  bitpacker<i8, 5, 30> bp;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) bp[i] = (i8)((int)i - 15);
+
+  ASSERT_EQ(bp.per_word, 12);
+  ASSERT_EQ(bp.word_count, 3);
+
+  decltype(bp)::word_items items{};
+
+  for (std::size_t w = 0; w < bp.word_count; ++w) {
+    bp.load_word_items(w, items);
+
+    for (std::size_t k = 0; k < bp.per_word; ++k) {
+      auto pos = w * bp.per_word + k;
+      ASSERT_EQ(items[k], pos < bp.size() ? bp[pos] : 0);
+    }
+  }
+}
+
+TEST(WordItemsTests, StoreKeepsPaddingZero) {
+  bitpacker<u8, 3, 25> bp, expected;
+  decltype(bp)::word_items items{};
+
+  items.fill(6);
+
+  for (std::size_t w = 0; w < bp.word_count; ++w) bp.store_word_items(w, items);
+
+  expected.fill(6);
+  ASSERT_TRUE(bp == expected);
+
+  bp.load_word_items(1, items);
+  items[0] = 1;
+  bp.store_word_items(1, items);
+  ASSERT_EQ(bp[21], 1);
+  ASSERT_EQ(bp[20], 6);
+}
+
+TEST(WordItemsTests, EnumAndZigzagRoundTrip) {
+  bitpacker<i8enum, 4, 20> e;
+  bitpacker<i16, 7, 10, zigzag> z;
+  decltype(e)::word_items e_items{};
+  decltype(z)::word_items z_items{};
+
+  for (auto& x : e_items) x = i8enum::MinusOne;
+  e.store_word_items(0, e_items);
+  ASSERT_EQ(e[15], i8enum::MinusOne);
+  ASSERT_EQ(e[16], i8enum::Zero);
+
+  for (std::size_t k = 0; k < z.per_word; ++k) z_items[k] = (i16)(k * 7 - 30);
+  z.store_word_items(0, z_items);
+  for (std::size_t k = 0; k < z.per_word; ++k)
+    ASSERT_EQ(z[k], (i16)(k * 7 - 30));
+}
+
+TEST(WordItemsTests, ForEachWordCoversEveryItem) {
+  bitpacker<u16, 11, 40> bp;
+  std::vector<u16> seen;
+
+  for (std::size_t i = 0; i < bp.size(); ++i) bp[i] = (u16)(i * 50);
+
+  bp.for_each_word([&](std::size_t first, const auto& items,
+                       std::size_t count) {
+    ASSERT_EQ(first, seen.size());
+    ASSERT_LE(count, items.size());
+    for (std::size_t k = 0; k < count; ++k) seen.push_back(items[k]);
+  });
+
+  ASSERT_EQ(seen.size(), bp.size());
+  for (std::size_t i = 0; i < bp.size(); ++i) ASSERT_EQ(seen[i], bp[i]);
+}
+
+}  // namespace bp3k::tests
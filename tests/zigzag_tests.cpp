@@ -0,0 +1,59 @@
+#include "bp3k_tests.h"
+
+namespace bp3k::tests {
+
+TEST(ZigZagTests, RoundTripsFullRange) {
+  bp3k::ibitpacker<5, 40, bp3k::zigzag> bp;
+  using T = typename decltype(bp)::value_type;
+
+  for (std::size_t i = 0; i < bp.size(); ++i)
+    bp[i] = (T)(decltype(bp)::value_min + (int)(i % 32));
+
+  for (std::size_t i = 0; i < bp.size(); ++i)
+    ASSERT_EQ(bp.at(i), (T)(decltype(bp)::value_min + (int)(i % 32)));
+
+  ASSERT_EQ(decltype(bp)::value_min, -16);
+  ASSERT_EQ(decltype(bp)::value_max, 15);
+}
+
+TEST(ZigZagTests, SmallMagnitudesHaveSmallCodes) {
+  bp3k::bitpacker<i16, 16, 4, bp3k::zigzag> bp;
+
+  bp[0] = (i16)0;
+  bp[1] = (i16)-1;
+  bp[2] = (i16)1;
+  bp[3] = (i16)-2;
+
+  ASSERT_EQ(bp.data()[0], 0x0000000100020003ull);
+  ASSERT_EQ(bp[1], (i16)-1);
+  ASSERT_EQ(bp[3], (i16)-2);
+}
+
+TEST(ZigZagTests, FillAndProxyAssignment) {
+  bp3k::bitpacker<i8enum, 4, 29, bp3k::zigzag> lhs(i8enum::MinusEight);
+  bp3k::bitpacker<i8enum, 4, 29, bp3k::zigzag> rhs(i8enum::Seven);
+
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    ASSERT_EQ(lhs[i], i8enum::MinusEight);
+    lhs[i] = rhs[i];
+    ASSERT_EQ(lhs[i], i8enum::Seven);
+  }
+
+  ASSERT_TRUE(lhs == rhs);
+  ASSERT_EQ(lhs.front(), i8enum::Seven);
+  ASSERT_EQ(lhs.back(), i8enum::Seven);
+}
+
+TEST(ZigZagTests, EncodingTypeDefaultsToTwosComplement) {
+  constexpr bool default_match =
+      std::is_same<bp3k::ibitpacker<6, 10>::encoding_type,
+                   bp3k::twos_complement>::value;
+  constexpr bool zigzag_match =
+      std::is_same<bp3k::ibitpacker<6, 10, bp3k::zigzag>,
+                   bp3k::bitpacker<i8, 6, 10, bp3k::zigzag>>::value;
+
+  ASSERT_TRUE(default_match);
+  ASSERT_TRUE(zigzag_match);
+}
+
+}  // namespace bp3k::tests